@@ -288,5 +288,20 @@ system.workload = SEWorkload.init_compatible(mp0_path)
 if args.wait_gdb:
     system.workload.wait_for_remote_gdb = True
 
+if ObjectList.is_kvm_cpu(CPUClass) or ObjectList.is_kvm_cpu(FutureClass):
+    # Assign KVM CPUs to their own event queues / threads, so the guest
+    # threads of a multithreaded process run on separate host threads. This
+    # has to be done after creating caches and other child objects since
+    # these mustn't inherit the CPU event queue.
+    for i, cpu in enumerate(system.cpu):
+        for obj in cpu.descendants():
+            obj.eventq_index = 0
+        cpu.eventq_index = i + 1
+
 root = Root(full_system=False, system=system)
+
+if ObjectList.is_kvm_cpu(CPUClass) or ObjectList.is_kvm_cpu(FutureClass):
+    # Required for running kvm on multiple host cores.
+    # Uses gem5's parallel event queue feature
+    root.sim_quantum = int(1e9)  # 1 ms
 Simulation.run(args, root, system, FutureClass)
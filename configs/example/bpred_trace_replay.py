@@ -0,0 +1,84 @@
+# Copyright (c) 2023 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Evaluate branch predictors on a branch trace without simulating the
+workload again. Record the trace by adding a BranchTraceRecorder to an
+AtomicSimpleCPU, e.g., with `cpu.addBranchTraceProbe("branch.trace")`,
+and replay it on any number of predictors:
+
+```
+./build/ALL/gem5.opt configs/example/bpred_trace_replay.py \
+    m5out/branch.trace --predictors LocalBP TournamentBP LTAGE
+```
+
+The mispredictions and the MPKI of every predictor are reported in
+stats.txt.
+"""
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import fatal
+
+parser = argparse.ArgumentParser(
+    description="Replay a branch trace on a set of branch predictors."
+)
+parser.add_argument("trace", type=str, help="The branch trace to replay.")
+parser.add_argument(
+    "--predictors",
+    nargs="+",
+    default=["LocalBP", "TournamentBP", "BiModeBP", "TAGE", "TAGE_SC_L_64KB"],
+    help="The branch predictor classes to evaluate.",
+)
+parser.add_argument(
+    "--threads",
+    type=int,
+    default=1,
+    help="Number of host threads replaying the trace, 0 uses all cores. "
+    "TAGE and perceptron predictors require 1.",
+)
+
+args = parser.parse_args()
+
+predictors = []
+for name in args.predictors:
+    predictor = getattr(m5.objects, name, None)
+    if predictor is None or not issubclass(predictor, BranchPredictor):
+        fatal(f"{name} is not a branch predictor.")
+    predictors.append(predictor())
+
+root = Root(full_system=False)
+root.replayer = BranchTraceReplayer(
+    predictors=predictors,
+    trace_file=args.trace,
+    num_threads=args.threads,
+)
+
+m5.instantiate()
+root.replayer.replay()
+m5.stats.dump()
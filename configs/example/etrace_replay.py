@@ -67,8 +67,19 @@ if args.cpu_type != "TraceCPU":
         "--cpu-type=TraceCPU\n"
     )
 
-if args.num_cpus > 1:
-    fatal("This script does not support multi-processor trace replay.\n")
+# Multi-processor replay takes one instruction and one data trace per CPU,
+# separated by commas. Each Trace CPU decodes its traces in background
+# threads, so the traces are decoded in parallel.
+inst_trace_files = (args.inst_trace_file or "").split(",")
+data_trace_files = (args.data_trace_file or "").split(",")
+if (
+    len(inst_trace_files) != args.num_cpus
+    or len(data_trace_files) != args.num_cpus
+):
+    fatal(
+        "Specify one instruction and one data trace file per CPU, "
+        "separated by commas.\n"
+    )
 
 # In this case FutureClass will be None as there is not fast forwarding or
 # switching
@@ -76,7 +87,7 @@ if args.num_cpus > 1:
 CPUClass.numThreads = numThreads
 
 system = System(
-    cpu=CPUClass(cpu_id=0),
+    cpu=[CPUClass(cpu_id=i) for i in range(args.num_cpus)],
     mem_mode=test_mem_mode,
     mem_ranges=[AddrRange(args.mem_size)],
     cache_line_size=args.cacheline_size,
@@ -110,9 +121,12 @@ for cpu in system.cpu:
 for cpu in system.cpu:
     cpu.createThreads()
 
-# Assign input trace files to the Trace CPU
-system.cpu.instTraceFile = args.inst_trace_file
-system.cpu.dataTraceFile = args.data_trace_file
+# Assign input trace files to the Trace CPUs
+for cpu, inst_trace_file, data_trace_file in zip(
+    system.cpu, inst_trace_files, data_trace_files
+):
+    cpu.instTraceFile = inst_trace_file
+    cpu.dataTraceFile = data_trace_file
 
 # Configure the classic memory system args
 MemClass = Simulation.setMemClass(args)
@@ -508,8 +508,7 @@ namespace X86ISA
                                 tc->pcState().instAddr());
 
                         Process *p = tc->getProcessPtr();
-                        const EmulationPageTable::Entry *pte =
-                            p->pTable->lookup(vaddr);
+                        auto pte = p->pTable->lookup(vaddr);
 
                         if (!pte && mode != BaseMMU::Execute) {
                             // penalize a "page fault" more
@@ -956,7 +955,7 @@ namespace X86ISA
             Addr alignedVaddr = p->pTable->pageAlign(vaddr);
             assert(alignedVaddr == virtPageAddr);
 
-            const EmulationPageTable::Entry *pte = p->pTable->lookup(vaddr);
+            auto pte = p->pTable->lookup(vaddr);
             if (!pte && sender_state->tlbMode != BaseMMU::Execute &&
                     p->fixupFault(vaddr)) {
                 pte = p->pTable->lookup(vaddr);
@@ -1160,8 +1159,7 @@ namespace X86ISA
                 Addr alignedVaddr = p->pTable->pageAlign(vaddr);
                 assert(alignedVaddr == virt_page_addr);
 
-                const EmulationPageTable::Entry *pte =
-                        p->pTable->lookup(vaddr);
+                auto pte = p->pTable->lookup(vaddr);
                 if (!pte && sender_state->tlbMode != BaseMMU::Execute &&
                         p->fixupFault(vaddr)) {
                     pte = p->pTable->lookup(vaddr);
@@ -94,7 +94,8 @@ class Decoder : public InstDecoder
     enums::DecoderFlavor decoderFlavor;
 
     /// A cache of decoded instruction objects.
-    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
+    static thread_local GenericISA::BasicDecodeCache<Decoder, ExtMachInst>
+        defaultCache;
     friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
 
     /**
@@ -123,6 +124,13 @@ class Decoder : public InstDecoder
      */
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
+    /**
+     * Decode the cases of the decode blocks which the ISA parser emits
+     * as lookup tables, one specialization per case.
+     */
+    template <int Node>
+    StaticInstPtr decodeNode(ExtMachInst mach_inst);
+
     /**
      * Decode a pre-decoded machine instruction.
      *
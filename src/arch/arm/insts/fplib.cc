@@ -41,6 +41,8 @@
 #include <cassert>
 #include <cmath>
 
+#include "base/fenv.hh"
+#include "base/host_fp.hh"
 #include "base/logging.hh"
 #include "fplib.hh"
 
@@ -1219,6 +1221,102 @@ fp64_compare_un(uint64_t a, uint64_t b, int mode, int *flags)
     return 0;
 }
 
+// The host FPU handles the common cases of the basic arithmetic operations
+// (see base/host_fp.hh), as long as there are no denormal operands which
+// have to be flushed to zero.
+
+static RoundingMode
+fp_host_rounding(int mode)
+{
+    switch (mode & 3) {
+      case FPLIB_RP:
+        return RoundingMode::Upward;
+      case FPLIB_RM:
+        return RoundingMode::Downward;
+      case FPLIB_RZ:
+        return RoundingMode::TowardZero;
+      default:
+        return RoundingMode::ToNearest;
+    }
+}
+
+template <typename Host>
+static inline bool
+fp_host_flushed(Host x, int mode)
+{
+    return (mode & FPLIB_FZ) && std::fpclassify(x) == FP_SUBNORMAL;
+}
+
+template <typename T, typename Host>
+static inline T
+fp_host_result(Host value, bool inexact, int *flags)
+{
+    if (inexact)
+        *flags |= FPLIB_IXC;
+    return floatToBits(value);
+}
+
+template <typename T>
+static inline bool
+fp_host_add(T a, T b, int neg, int mode, int *flags, T *result)
+{
+    auto x = bitsToFloat(a), y = bitsToFloat(b);
+    decltype(x) value;
+    bool inexact;
+    if (fp_host_flushed(x, mode) || fp_host_flushed(y, mode) ||
+            !host_fp::add(x, neg ? -y : y, fp_host_rounding(mode),
+                          value, inexact)) {
+        return false;
+    }
+    *result = fp_host_result<T>(value, inexact, flags);
+    return true;
+}
+
+template <typename T>
+static inline bool
+fp_host_mul(T a, T b, int mode, int *flags, T *result)
+{
+    auto x = bitsToFloat(a), y = bitsToFloat(b);
+    decltype(x) value;
+    bool inexact;
+    if (fp_host_flushed(x, mode) || fp_host_flushed(y, mode) ||
+            !host_fp::mul(x, y, fp_host_rounding(mode), value, inexact)) {
+        return false;
+    }
+    *result = fp_host_result<T>(value, inexact, flags);
+    return true;
+}
+
+template <typename T>
+static inline bool
+fp_host_div(T a, T b, int mode, int *flags, T *result)
+{
+    auto x = bitsToFloat(a), y = bitsToFloat(b);
+    decltype(x) value;
+    bool inexact;
+    if (fp_host_flushed(x, mode) || fp_host_flushed(y, mode) ||
+            !host_fp::div(x, y, fp_host_rounding(mode), value, inexact)) {
+        return false;
+    }
+    *result = fp_host_result<T>(value, inexact, flags);
+    return true;
+}
+
+template <typename T>
+static inline bool
+fp_host_sqrt(T a, int mode, int *flags, T *result)
+{
+    auto x = bitsToFloat(a);
+    decltype(x) value;
+    bool inexact;
+    if (fp_host_flushed(x, mode) ||
+            !host_fp::sqrt(x, fp_host_rounding(mode), value, inexact)) {
+        return false;
+    }
+    *result = fp_host_result<T>(value, inexact, flags);
+    return true;
+}
+
 static uint16_t
 fp16_add(uint16_t a, uint16_t b, int neg, int mode, int *flags)
 {
@@ -2367,6 +2465,172 @@ fplibCompareUN(uint64_t a, uint64_t b, FPSCR &fpscr)
     return x;
 }
 
+template <class T>
+bool
+fplibAddHost(T op1, T op2, FPSCR &fpscr, T &result)
+{
+    int flags = 0;
+    if (!fp_host_add(op1, op2, 0, modeConv(fpscr), &flags, &result))
+        return false;
+    set_fpscr0(fpscr, flags);
+    return true;
+}
+
+template <class T>
+bool
+fplibSubHost(T op1, T op2, FPSCR &fpscr, T &result)
+{
+    int flags = 0;
+    if (!fp_host_add(op1, op2, 1, modeConv(fpscr), &flags, &result))
+        return false;
+    set_fpscr0(fpscr, flags);
+    return true;
+}
+
+template <class T>
+bool
+fplibMulHost(T op1, T op2, FPSCR &fpscr, T &result)
+{
+    int flags = 0;
+    if (!fp_host_mul(op1, op2, modeConv(fpscr), &flags, &result))
+        return false;
+    set_fpscr0(fpscr, flags);
+    return true;
+}
+
+template <class T>
+bool
+fplibDivHost(T op1, T op2, FPSCR &fpscr, T &result)
+{
+    int flags = 0;
+    if (!fp_host_div(op1, op2, modeConv(fpscr), &flags, &result))
+        return false;
+    set_fpscr0(fpscr, flags);
+    return true;
+}
+
+template <class T>
+bool
+fplibSqrtHost(T op, FPSCR &fpscr, T &result)
+{
+    int flags = 0;
+    if (!fp_host_sqrt(op, modeConv(fpscr), &flags, &result))
+        return false;
+    set_fpscr0(fpscr, flags);
+    return true;
+}
+
+template bool fplibAddHost(uint32_t, uint32_t, FPSCR &, uint32_t &);
+template bool fplibAddHost(uint64_t, uint64_t, FPSCR &, uint64_t &);
+template bool fplibSubHost(uint32_t, uint32_t, FPSCR &, uint32_t &);
+template bool fplibSubHost(uint64_t, uint64_t, FPSCR &, uint64_t &);
+template bool fplibMulHost(uint32_t, uint32_t, FPSCR &, uint32_t &);
+template bool fplibMulHost(uint64_t, uint64_t, FPSCR &, uint64_t &);
+template bool fplibDivHost(uint32_t, uint32_t, FPSCR &, uint32_t &);
+template bool fplibDivHost(uint64_t, uint64_t, FPSCR &, uint64_t &);
+template bool fplibSqrtHost(uint32_t, FPSCR &, uint32_t &);
+template bool fplibSqrtHost(uint64_t, FPSCR &, uint64_t &);
+
+template <>
+uint32_t
+fplibAddEmulated(uint32_t op1, uint32_t op2, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint32_t result = fp32_add(op1, op2, 0, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint64_t
+fplibAddEmulated(uint64_t op1, uint64_t op2, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint64_t result = fp64_add(op1, op2, 0, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint32_t
+fplibSubEmulated(uint32_t op1, uint32_t op2, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint32_t result = fp32_add(op1, op2, 1, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint64_t
+fplibSubEmulated(uint64_t op1, uint64_t op2, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint64_t result = fp64_add(op1, op2, 1, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint32_t
+fplibMulEmulated(uint32_t op1, uint32_t op2, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint32_t result = fp32_mul(op1, op2, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint64_t
+fplibMulEmulated(uint64_t op1, uint64_t op2, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint64_t result = fp64_mul(op1, op2, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint32_t
+fplibDivEmulated(uint32_t op1, uint32_t op2, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint32_t result = fp32_div(op1, op2, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint64_t
+fplibDivEmulated(uint64_t op1, uint64_t op2, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint64_t result = fp64_div(op1, op2, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint32_t
+fplibSqrtEmulated(uint32_t op, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint32_t result = fp32_sqrt(op, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
+template <>
+uint64_t
+fplibSqrtEmulated(uint64_t op, FPSCR &fpscr)
+{
+    int flags = 0;
+    uint64_t result = fp64_sqrt(op, modeConv(fpscr), &flags);
+    set_fpscr0(fpscr, flags);
+    return result;
+}
+
 template <>
 uint16_t
 fplibAbs(uint16_t op)
@@ -2402,9 +2666,9 @@ template <>
 uint32_t
 fplibAdd(uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint32_t result = fp32_add(op1, op2, 0, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint32_t result;
+    if (!fplibAddHost(op1, op2, fpscr, result))
+        result = fplibAddEmulated(op1, op2, fpscr);
     return result;
 }
 
@@ -2412,9 +2676,9 @@ template <>
 uint64_t
 fplibAdd(uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint64_t result = fp64_add(op1, op2, 0, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint64_t result;
+    if (!fplibAddHost(op1, op2, fpscr, result))
+        result = fplibAddEmulated(op1, op2, fpscr);
     return result;
 }
 
@@ -2917,9 +3181,9 @@ template <>
 uint32_t
 fplibDiv(uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint32_t result = fp32_div(op1, op2, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint32_t result;
+    if (!fplibDivHost(op1, op2, fpscr, result))
+        result = fplibDivEmulated(op1, op2, fpscr);
     return result;
 }
 
@@ -2927,9 +3191,9 @@ template <>
 uint64_t
 fplibDiv(uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint64_t result = fp64_div(op1, op2, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint64_t result;
+    if (!fplibDivHost(op1, op2, fpscr, result))
+        result = fplibDivEmulated(op1, op2, fpscr);
     return result;
 }
 
@@ -3377,9 +3641,9 @@ template <>
 uint32_t
 fplibMul(uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint32_t result = fp32_mul(op1, op2, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint32_t result;
+    if (!fplibMulHost(op1, op2, fpscr, result))
+        result = fplibMulEmulated(op1, op2, fpscr);
     return result;
 }
 
@@ -3387,9 +3651,9 @@ template <>
 uint64_t
 fplibMul(uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint64_t result = fp64_mul(op1, op2, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint64_t result;
+    if (!fplibMulHost(op1, op2, fpscr, result))
+        result = fplibMulEmulated(op1, op2, fpscr);
     return result;
 }
 
@@ -3445,7 +3709,7 @@ fplibMulX(uint32_t op1, uint32_t op2, FPSCR &fpscr)
             result = fp32_infinity(sgn1 ^ sgn2);
         } else if (!mnt1 || !mnt2) {
             result = fp32_zero(sgn1 ^ sgn2);
-        } else {
+        } else if (!fp_host_mul(op1, op2, mode, &flags, &result)) {
             result = fp32_mul(op1, op2, mode, &flags);
         }
     }
@@ -3476,7 +3740,7 @@ fplibMulX(uint64_t op1, uint64_t op2, FPSCR &fpscr)
             result = fp64_infinity(sgn1 ^ sgn2);
         } else if (!mnt1 || !mnt2) {
             result = fp64_zero(sgn1 ^ sgn2);
-        } else {
+        } else if (!fp_host_mul(op1, op2, mode, &flags, &result)) {
             result = fp64_mul(op1, op2, mode, &flags);
         }
     }
@@ -4317,9 +4581,9 @@ template <>
 uint32_t
 fplibSqrt(uint32_t op, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint32_t result = fp32_sqrt(op, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint32_t result;
+    if (!fplibSqrtHost(op, fpscr, result))
+        result = fplibSqrtEmulated(op, fpscr);
     return result;
 }
 
@@ -4327,9 +4591,9 @@ template <>
 uint64_t
 fplibSqrt(uint64_t op, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint64_t result = fp64_sqrt(op, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint64_t result;
+    if (!fplibSqrtHost(op, fpscr, result))
+        result = fplibSqrtEmulated(op, fpscr);
     return result;
 }
 
@@ -4347,9 +4611,9 @@ template <>
 uint32_t
 fplibSub(uint32_t op1, uint32_t op2, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint32_t result = fp32_add(op1, op2, 1, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint32_t result;
+    if (!fplibSubHost(op1, op2, fpscr, result))
+        result = fplibSubEmulated(op1, op2, fpscr);
     return result;
 }
 
@@ -4357,9 +4621,9 @@ template <>
 uint64_t
 fplibSub(uint64_t op1, uint64_t op2, FPSCR &fpscr)
 {
-    int flags = 0;
-    uint64_t result = fp64_add(op1, op2, 1, modeConv(fpscr), &flags);
-    set_fpscr0(fpscr, flags);
+    uint64_t result;
+    if (!fplibSubHost(op1, op2, fpscr, result))
+        result = fplibSubEmulated(op1, op2, fpscr);
     return result;
 }
 
@@ -4494,7 +4758,9 @@ fplibTrigSMul(uint32_t op1, uint32_t op2, FPSCR &fpscr)
     uint32_t mnt;
 
     int mode = modeConv(fpscr);
-    uint32_t result = fp32_mul(op1, op1, mode, &flags);
+    uint32_t result;
+    if (!fp_host_mul(op1, op1, mode, &flags, &result))
+        result = fp32_mul(op1, op1, mode, &flags);
     set_fpscr0(fpscr, flags);
 
     fp32_unpack(&sgn, &exp, &mnt, result, mode, &flags);
@@ -4513,7 +4779,9 @@ fplibTrigSMul(uint64_t op1, uint64_t op2, FPSCR &fpscr)
     uint64_t mnt;
 
     int mode = modeConv(fpscr);
-    uint64_t result = fp64_mul(op1, op1, mode, &flags);
+    uint64_t result;
+    if (!fp_host_mul(op1, op1, mode, &flags, &result))
+        result = fp64_mul(op1, op1, mode, &flags);
     set_fpscr0(fpscr, flags);
 
     fp64_unpack(&sgn, &exp, &mnt, result, mode, &flags);
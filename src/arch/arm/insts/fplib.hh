@@ -179,6 +179,33 @@ T fplibDefaultNaN();
 /** Floating-point  JS convert to a signed integer, with rounding to zero. */
 uint32_t fplibFPToFixedJS(uint64_t op, FPSCR &fpscr, bool Is64, uint8_t &nz);
 
+/**
+ * The two implementations of single and double precision fplibAdd,
+ * fplibSub, fplibMul, fplibDiv and fplibSqrt. The host FPU versions
+ * return false and leave result and fpscr alone if the host FPU can't
+ * give the same result as the integer emulation (see base/host_fp.hh).
+ */
+template <class T>
+bool fplibAddHost(T op1, T op2, FPSCR &fpscr, T &result);
+template <class T>
+bool fplibSubHost(T op1, T op2, FPSCR &fpscr, T &result);
+template <class T>
+bool fplibMulHost(T op1, T op2, FPSCR &fpscr, T &result);
+template <class T>
+bool fplibDivHost(T op1, T op2, FPSCR &fpscr, T &result);
+template <class T>
+bool fplibSqrtHost(T op, FPSCR &fpscr, T &result);
+template <class T>
+T fplibAddEmulated(T op1, T op2, FPSCR &fpscr);
+template <class T>
+T fplibSubEmulated(T op1, T op2, FPSCR &fpscr);
+template <class T>
+T fplibMulEmulated(T op1, T op2, FPSCR &fpscr);
+template <class T>
+T fplibDivEmulated(T op1, T op2, FPSCR &fpscr);
+template <class T>
+T fplibSqrtEmulated(T op, FPSCR &fpscr);
+
 /* Function specializations... */
 template <>
 uint16_t fplibAbs(uint16_t op);
@@ -417,6 +444,26 @@ template <>
 uint32_t fplibDefaultNaN();
 template <>
 uint64_t fplibDefaultNaN();
+template <>
+uint32_t fplibAddEmulated(uint32_t op1, uint32_t op2, FPSCR &fpscr);
+template <>
+uint64_t fplibAddEmulated(uint64_t op1, uint64_t op2, FPSCR &fpscr);
+template <>
+uint32_t fplibSubEmulated(uint32_t op1, uint32_t op2, FPSCR &fpscr);
+template <>
+uint64_t fplibSubEmulated(uint64_t op1, uint64_t op2, FPSCR &fpscr);
+template <>
+uint32_t fplibMulEmulated(uint32_t op1, uint32_t op2, FPSCR &fpscr);
+template <>
+uint64_t fplibMulEmulated(uint64_t op1, uint64_t op2, FPSCR &fpscr);
+template <>
+uint32_t fplibDivEmulated(uint32_t op1, uint32_t op2, FPSCR &fpscr);
+template <>
+uint64_t fplibDivEmulated(uint64_t op1, uint64_t op2, FPSCR &fpscr);
+template <>
+uint32_t fplibSqrtEmulated(uint32_t op, FPSCR &fpscr);
+template <>
+uint64_t fplibSqrtEmulated(uint64_t op, FPSCR &fpscr);
 
 } // namespace ArmISA
 } // namespace gem5
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "arch/arm/insts/fplib.hh"
+#include "base/bitfield.hh"
+#include "base/gtest/host_fp_operands.hh"
+
+using namespace gem5;
+using namespace ArmISA;
+
+namespace
+{
+
+// Every combination of the rounding mode, flush-to-zero and default NaN
+// controls.
+std::vector<FPSCR>
+controls()
+{
+    std::vector<FPSCR> fpscrs;
+    for (int mode = 0; mode < 16; mode++) {
+        FPSCR fpscr = 0;
+        fpscr.rMode = mode & 3;
+        fpscr.fz = bits(mode, 2);
+        fpscr.dn = bits(mode, 3);
+        fpscrs.push_back(fpscr);
+    }
+    return fpscrs;
+}
+
+// Check that the host FPU, when it takes an operation, gives the same
+// result and cumulative exception flags as the emulation, and that the
+// public function agrees with the emulation either way.
+template <typename T, typename Host, typename Emulated, typename Op>
+void
+check(T a, T b, Host host, Emulated emulated, Op op)
+{
+    for (const FPSCR control: controls()) {
+        FPSCR expected_fpscr = control;
+        T expected = emulated(a, b, expected_fpscr);
+
+        FPSCR fpscr = control;
+        T result;
+        if (host(a, b, fpscr, result)) {
+            ASSERT_EQ(expected, result) << std::hex << "a: " << a <<
+                " b: " << b << " fpscr: " << (uint32_t)control;
+            ASSERT_EQ((uint32_t)expected_fpscr, (uint32_t)fpscr) <<
+                std::hex << "a: " << a << " b: " << b << " fpscr: " <<
+                (uint32_t)control;
+        } else {
+            ASSERT_EQ((uint32_t)control, (uint32_t)fpscr);
+        }
+
+        fpscr = control;
+        ASSERT_EQ(expected, op(a, b, fpscr)) << std::hex << "a: " << a <<
+            " b: " << b << " fpscr: " << (uint32_t)control;
+        ASSERT_EQ((uint32_t)expected_fpscr, (uint32_t)fpscr) << std::hex <<
+            "a: " << a << " b: " << b << " fpscr: " << (uint32_t)control;
+    }
+}
+
+template <typename T>
+void
+checkAll(T a, T b)
+{
+    check(a, b, fplibAddHost<T>, fplibAddEmulated<T>, fplibAdd<T>);
+    check(a, b, fplibSubHost<T>, fplibSubEmulated<T>, fplibSub<T>);
+    check(a, b, fplibMulHost<T>, fplibMulEmulated<T>, fplibMul<T>);
+    check(a, b, fplibDivHost<T>, fplibDivEmulated<T>, fplibDiv<T>);
+    check(a, b,
+            [](T x, T, FPSCR &f, T &r) { return fplibSqrtHost(x, f, r); },
+            [](T x, T, FPSCR &f) { return fplibSqrtEmulated(x, f); },
+            [](T x, T, FPSCR &f) { return fplibSqrt(x, f); });
+}
+
+} // anonymous namespace
+
+TEST(ArmHostFp, F32)
+{
+    host_fp_operands::forPairs<uint32_t>(20000, checkAll<uint32_t>);
+}
+
+TEST(ArmHostFp, F64)
+{
+    host_fp_operands::forPairs<uint64_t>(20000, checkAll<uint64_t>);
+}
+
+TEST(ArmHostFp, RoundingModes)
+{
+    // 1 + 2^-30 isn't representable in single precision, so it rounds up
+    // only in the round towards plus infinity mode.
+    const uint32_t one = 0x3f800000, tiny = 0x30800000;
+    const uint32_t rounded[] = {one, one + 1, one, one};
+    for (int rmode = 0; rmode < 4; rmode++) {
+        FPSCR fpscr = 0;
+        fpscr.rMode = rmode;
+        uint32_t result;
+        ASSERT_TRUE(fplibAddHost(one, tiny, fpscr, result));
+        EXPECT_EQ(rounded[rmode], result);
+        EXPECT_EQ(1, fpscr.ixc);
+    }
+}
+
+TEST(ArmHostFp, FlushToZero)
+{
+    // Subnormal operands are flushed by the emulation, which the host FPU
+    // doesn't do, so it has to leave them alone under FZ.
+    const uint64_t subnormal = 0x000fffffffffffff, one = 0x3ff0000000000000;
+    FPSCR fpscr = 0;
+    uint64_t result;
+    EXPECT_TRUE(fplibAddHost(subnormal, one, fpscr, result));
+    fpscr = 0;
+    fpscr.fz = 1;
+    EXPECT_FALSE(fplibAddHost(subnormal, one, fpscr, result));
+    EXPECT_FALSE(fplibMulHost(subnormal, one, fpscr, result));
+    EXPECT_EQ(1 << 24, (uint32_t)fpscr);
+}
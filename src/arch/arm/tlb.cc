@@ -40,6 +40,7 @@
 
 #include "arch/arm/tlb.hh"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -63,8 +64,18 @@ TLB::TLB(const ArmTLBParams &p)
       isStage2(p.is_stage2),
       _walkCache(false),
       tableWalker(nullptr),
-      stats(*this), rangeMRU(1), vmid(0)
+      stats(*this), rangeMRU(1), vmid(0),
+      nextMRU(p.size), prevMRU(p.size), mruIdx(0), lruIdx(p.size - 1),
+      lastMoved(p.size), moveCount(0), pageSizeCount{}
 {
+    // The entries start in table order, with table[0] being the MRU one
+    for (int x = 0; x < size; ++x) {
+        nextMRU[x] = x + 1 < size ? x + 1 : -1;
+        prevMRU[x] = x - 1;
+        lastMoved[x] = size - x;
+    }
+    moveCount = size;
+
     for (int lvl = LookupLevel::L0;
          lvl < LookupLevel::Num_ArmLookupLevel; lvl++) {
 
@@ -102,6 +113,115 @@ TLB::setTableWalker(TableWalker *table_walker)
     tableWalker->setTlb(this);
 }
 
+void
+TLB::indexEntry(int idx)
+{
+    const TlbEntry &entry = table[idx];
+    assert(entry.valid);
+
+    pageIndex.emplace(pageKey(entry.vpn, entry.N), idx);
+    asidIndex.emplace(entry.asid, idx);
+    if (pageSizeCount[entry.N]++ == 0)
+        pageSizes.push_back(entry.N);
+}
+
+void
+TLB::invalidateEntry(int idx)
+{
+    TlbEntry &entry = table[idx];
+    assert(entry.valid);
+
+    auto erase = [idx](auto &index, auto key) {
+        auto range = index.equal_range(key);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == idx) {
+                index.erase(it);
+                return;
+            }
+        }
+        panic("TLB entry missing from its index");
+    };
+    erase(pageIndex, pageKey(entry.vpn, entry.N));
+    erase(asidIndex, entry.asid);
+    if (--pageSizeCount[entry.N] == 0) {
+        pageSizes.erase(
+            std::find(pageSizes.begin(), pageSizes.end(), entry.N));
+    }
+
+    entry.valid = false;
+}
+
+void
+TLB::moveToMRU(int idx)
+{
+    lastMoved[idx] = ++moveCount;
+    if (idx == mruIdx)
+        return;
+
+    // Unlink the entry...
+    nextMRU[prevMRU[idx]] = nextMRU[idx];
+    if (idx == lruIdx)
+        lruIdx = prevMRU[idx];
+    else
+        prevMRU[nextMRU[idx]] = prevMRU[idx];
+
+    // ...and put it in front of the list
+    prevMRU[idx] = -1;
+    nextMRU[idx] = mruIdx;
+    prevMRU[mruIdx] = idx;
+    mruIdx = idx;
+}
+
+template <class F>
+void
+TLB::forEachPageCandidate(Addr va, F f) const
+{
+    // Pages are usually mapped by a few entries, which are gathered and
+    // sorted on the stack. Only pages mapped by many entries, e.g. for
+    // many ASIDs, spill to the heap.
+    constexpr int max_candidates = 16;
+    int buf[max_candidates];
+    int count = 0;
+    std::vector<int> spill;
+    for (auto n : pageSizes) {
+        auto range = pageIndex.equal_range(pageKey(va >> n, n));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (count < max_candidates) {
+                buf[count++] = it->second;
+            } else {
+                if (spill.empty())
+                    spill.assign(buf, buf + count);
+                spill.push_back(it->second);
+            }
+        }
+    }
+
+    auto more_recent = [this](int a, int b) {
+        return lastMoved[a] > lastMoved[b];
+    };
+    int *first = buf;
+    int *last = buf + count;
+    if (!spill.empty()) {
+        first = spill.data();
+        last = first + spill.size();
+        std::sort(first, last, more_recent);
+    } else {
+        for (int *i = first + 1; i < last; ++i) {
+            int idx = *i;
+            int *j = i;
+            for (; j > first && more_recent(idx, j[-1]); --j)
+                *j = j[-1];
+            *j = idx;
+        }
+    }
+
+    // The candidates are gathered first, so f may invalidate entries.
+    for (int *i = first; i < last; ++i) {
+        if (!f(*i))
+            return;
+    }
+}
+
 TlbEntry*
 TLB::match(const Lookup &lookup_data)
 {
@@ -113,18 +233,19 @@ TLB::match(const Lookup &lookup_data)
     std::vector<std::pair<int, const TlbEntry*>> hits{
         LookupLevel::Num_ArmLookupLevel, {0, nullptr}};
 
-    int x = 0;
-    while (x < size) {
+    // Only the entries of the page containing the address can match.
+    // Check them in replacement order, as the entries used to be stored.
+    forEachPageCandidate(lookup_data.va, [&](int x) {
         if (table[x].match(lookup_data)) {
             const TlbEntry &entry = table[x];
             hits[entry.lookupLevel] = std::make_pair(x, &entry);
 
             // This is a complete translation, no need to loop further
             if (!entry.partial)
-                break;
+                return false;
         }
-        ++x;
-    }
+        return true;
+    });
 
     // Loop over the list of TLB entries matching our translation
     // request, starting from the highest lookup level (complete
@@ -139,15 +260,14 @@ TLB::match(const Lookup &lookup_data)
         // Maintaining LRU array
         // We only move the hit entry ahead when the position is higher
         // than rangeMRU
-        if (idx > rangeMRU && !lookup_data.functional) {
-            TlbEntry tmp_entry = *entry;
-            for (int i = idx; i > 0; i--)
-                table[i] = table[i - 1];
-            table[0] = tmp_entry;
-            return &table[0];
-        } else {
-            return &table[idx];
+        if (!lookup_data.functional) {
+            int pos = 0;
+            for (int x = mruIdx; x != idx && pos <= rangeMRU; x = nextMRU[x])
+                ++pos;
+            if (pos > rangeMRU)
+                moveToMRU(idx);
         }
+        return &table[idx];
     }
 
     return nullptr;
@@ -248,19 +368,22 @@ TLB::insert(TlbEntry &entry)
             entry.ap, static_cast<uint8_t>(entry.domain), entry.ns, entry.nstid,
             entry.isHyp);
 
-    if (table[size - 1].valid)
+    // inserting to MRU position and evicting the LRU one
+    const int idx = lruIdx;
+    TlbEntry &victim = table[idx];
+    if (victim.valid) {
         DPRINTF(TLB, " - Replacing Valid entry %#x, asn %d vmn %d ppn %#x "
                 "size: %#x ap:%d ns:%d nstid:%d g:%d isHyp:%d el: %d\n",
-                table[size-1].vpn << table[size-1].N, table[size-1].asid,
-                table[size-1].vmid, table[size-1].pfn << table[size-1].N,
-                table[size-1].size, table[size-1].ap, table[size-1].ns,
-                table[size-1].nstid, table[size-1].global, table[size-1].isHyp,
-                table[size-1].el);
+                victim.vpn << victim.N, victim.asid, victim.vmid,
+                victim.pfn << victim.N, victim.size, victim.ap, victim.ns,
+                victim.nstid, victim.global, victim.isHyp, victim.el);
+        invalidateEntry(idx);
+    }
 
-    // inserting to MRU position and evicting the LRU one
-    for (int i = size - 1; i > 0; --i)
-        table[i] = table[i-1];
-    table[0] = entry;
+    victim = entry;
+    if (victim.valid)
+        indexEntry(idx);
+    moveToMRU(idx);
 
     stats.inserts++;
     ppRefills->notify(1);
@@ -283,14 +406,11 @@ TLB::multiInsert(TlbEntry &entry)
 void
 TLB::printTlb() const
 {
-    int x = 0;
-    TlbEntry *te;
     DPRINTF(TLB, "Current TLB contents:\n");
-    while (x < size) {
-        te = &table[x];
+    for (int x = mruIdx; x != -1; x = nextMRU[x]) {
+        const TlbEntry *te = &table[x];
         if (te->valid)
             DPRINTF(TLB, " *  %s\n", te->print());
-        ++x;
     }
 }
 
@@ -311,22 +431,42 @@ TLB::flushAll()
         ++x;
     }
 
+    pageIndex.clear();
+    asidIndex.clear();
+    pageSizeCount.fill(0);
+    pageSizes.clear();
+
     stats.flushTlb++;
 }
 
 void
 TLB::flush(const TLBIOp& tlbi_op)
 {
-    int x = 0;
-    TlbEntry *te;
-    while (x < size) {
-        te = &table[x];
+    auto flush_entry = [&](int x) {
+        TlbEntry *te = &table[x];
         if (tlbi_op.match(te, vmid)) {
             DPRINTF(TLB, " -  %s\n", te->print());
-            te->valid = false;
+            invalidateEntry(x);
             stats.flushedEntries++;
         }
-        ++x;
+        return true;
+    };
+
+    // Invalidations by VA or ASID only need to check the entries of
+    // that page or ASID.
+    if (auto va = tlbi_op.flushVa()) {
+        forEachPageCandidate(*va, flush_entry);
+    } else if (auto asid = tlbi_op.flushAsid()) {
+        // Invalidating entries changes the ASID index.
+        std::vector<int> candidates;
+        auto range = asidIndex.equal_range(*asid);
+        for (auto it = range.first; it != range.second; ++it)
+            candidates.push_back(it->second);
+        for (int x : candidates)
+            flush_entry(x);
+    } else {
+        for (int x = 0; x < size; ++x)
+            flush_entry(x);
     }
 
     stats.flushTlb++;
@@ -41,6 +41,9 @@
 #ifndef __ARCH_ARM_TLB_HH__
 #define __ARCH_ARM_TLB_HH__
 
+#include <array>
+#include <unordered_map>
+#include <vector>
 
 #include "arch/arm/faults.hh"
 #include "arch/arm/pagetable.hh"
@@ -156,6 +159,39 @@ class TLB : public BaseTLB
     int rangeMRU; //On lookup, only move entries ahead when outside rangeMRU
     vmid_t vmid;
 
+    /**
+     * Replacement order of the table entries as a doubly linked list,
+     * from the most recently used entry (mruIdx) to the least recently
+     * used one (lruIdx). Invalidated entries keep their position, so an
+     * insertion always replaces the LRU entry.
+     */
+    std::vector<int> nextMRU;
+    std::vector<int> prevMRU;
+    int mruIdx;
+    int lruIdx;
+
+    /**
+     * Time stamp of the last move of each entry to the MRU position.
+     * Sorting by it gives the replacement order of a few entries without
+     * walking the list.
+     */
+    std::vector<uint64_t> lastMoved;
+    uint64_t moveCount;
+
+    /**
+     * Valid entries indexed by their virtual page number and page size
+     * (see pageKey), and by their ASID. Lookups and TLBI by VA probe the
+     * page index once for every page size present in the TLB, so they
+     * don't have to check every entry in large TLBs.
+     */
+    std::unordered_multimap<Addr, int> pageIndex;
+    std::unordered_multimap<uint16_t, int> asidIndex;
+
+    /** Number of valid entries per page size (TlbEntry::N) */
+    std::array<int, 64> pageSizeCount;
+    /** Page sizes (TlbEntry::N) of the valid entries */
+    std::vector<uint8_t> pageSizes;
+
   public:
     using Params = ArmTLBParams;
     using Lookup = TlbEntry::Lookup;
@@ -265,6 +301,28 @@ class TLB : public BaseTLB
     // invalid and call updateMiscReg if necessary.
 
   private:
+    static Addr
+    pageKey(Addr vpn, uint8_t n)
+    {
+        return (vpn << 6) | n;
+    }
+
+    /** Add a valid entry to the page and ASID indices */
+    void indexEntry(int idx);
+
+    /** Invalidate an entry and remove it from the indices */
+    void invalidateEntry(int idx);
+
+    /** Move an entry to the MRU position */
+    void moveToMRU(int idx);
+
+    /**
+     * Call f with the valid entries which may translate va, in
+     * replacement order, until it returns false.
+     */
+    template <class F>
+    void forEachPageCandidate(Addr va, F f) const;
+
     /** Remove any entries that match both a va and asn
      * @param mva virtual address to flush
      * @param asn contextid/asn to flush on match
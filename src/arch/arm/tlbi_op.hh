@@ -38,6 +38,8 @@
 #ifndef __ARCH_ARM_TLBI_HH__
 #define __ARCH_ARM_TLBI_HH__
 
+#include <optional>
+
 #include "arch/arm/system.hh"
 #include "arch/arm/tlb.hh"
 #include "cpu/thread_context.hh"
@@ -100,6 +102,27 @@ class TLBIOp
         return false;
     }
 
+    /**
+     * Return the virtual address if the TLBI op only flushes
+     * entries translating that address. The TLB uses it to look
+     * up the candidate entries instead of checking all of them.
+     */
+    virtual std::optional<Addr>
+    flushVa() const
+    {
+        return std::nullopt;
+    }
+
+    /**
+     * Return the ASID if the TLBI op only flushes entries tagged
+     * with that ASID.
+     */
+    virtual std::optional<uint16_t>
+    flushAsid() const
+    {
+        return std::nullopt;
+    }
+
     bool secureLookup;
     ExceptionLevel targetEL;
 };
@@ -237,6 +260,12 @@ class TLBIASID : public TLBIOp
 
     bool match(TlbEntry *entry, vmid_t curr_vmid) const override;
 
+    std::optional<uint16_t>
+    flushAsid() const override
+    {
+        return asid;
+    }
+
     uint16_t asid;
     bool inHost;
     bool el2Enabled;
@@ -311,6 +340,12 @@ class TLBIMVAA : public TLBIOp
 
     bool match(TlbEntry *entry, vmid_t curr_vmid) const override;
 
+    std::optional<Addr>
+    flushVa() const override
+    {
+        return sext<56>(addr);
+    }
+
     Addr addr;
     bool inHost;
     bool lastLevel;
@@ -330,6 +365,12 @@ class TLBIMVA : public TLBIOp
 
     bool match(TlbEntry *entry, vmid_t curr_vmid) const override;
 
+    std::optional<Addr>
+    flushVa() const override
+    {
+        return sext<56>(addr);
+    }
+
     Addr addr;
     uint16_t asid;
     bool inHost;
@@ -39,6 +39,18 @@ namespace gem5
 namespace GenericISA
 {
 
+/**
+ * A decode cache which is meant to be shared by all the decoders of an ISA.
+ * Decoded instructions are kept in per-page arrays indexed by the fetch
+ * address, backed by a map from machine instructions to StaticInsts. An
+ * array entry is only used if the machine instruction it was decoded from
+ * matches the one being decoded, so self-modifying code and different
+ * mappings of the same address are handled transparently.
+ *
+ * StaticInsts aren't reference counted atomically, so they must not be
+ * shared between threads. The decoders keep the cache thread_local, which
+ * shares it between all the CPUs simulated in the same event queue thread.
+ */
 template <typename Decoder, typename EMI>
 class BasicDecodeCache
 {
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GENERIC_WALK_CACHE_HH__
+#define __ARCH_GENERIC_WALK_CACHE_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A paging-structure cache for page table walkers. It holds non-leaf page
+ * table entries so a walk which hits can skip the upper levels of the page
+ * table and start with the table the cached entry points to.
+ *
+ * Entries are tagged with the root of the page table, the level of the
+ * cached entry and the virtual address bits translated down to that level,
+ * so the cache never has to be flushed on an address space switch. It does
+ * have to be flushed whenever the page tables may have been changed, i.e.
+ * when the TLB is flushed. The cache is fully associative with LRU
+ * replacement, and is disabled if its size is zero.
+ */
+class WalkCache
+{
+  public:
+    struct Entry
+    {
+        /** Physical address of the next level table. */
+        Addr table = 0;
+        /** ISA specific attributes gathered from the levels walked. */
+        uint64_t attrs = 0;
+    };
+
+  private:
+    struct Line
+    {
+        bool valid = false;
+        Addr root = 0;
+        int level = 0;
+        Addr tag = 0;
+        uint64_t lastUsed = 0;
+        Entry entry;
+    };
+
+    std::vector<Line> lines;
+    uint64_t useCount = 0;
+
+  public:
+    explicit WalkCache(unsigned size) : lines(size) {}
+
+    bool enabled() const { return !lines.empty(); }
+
+    /**
+     * Look up the entry at a level of the page table.
+     *
+     * @param root Address of the root table of the walk.
+     * @param level Level of the page table entry.
+     * @param tag Virtual address bits translated down to that level.
+     * @return The cached entry, or nullptr on a miss.
+     */
+    const Entry *
+    lookup(Addr root, int level, Addr tag)
+    {
+        for (auto &line: lines) {
+            if (line.valid && line.level == level && line.tag == tag &&
+                    line.root == root) {
+                line.lastUsed = ++useCount;
+                return &line.entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void
+    insert(Addr root, int level, Addr tag, const Entry &entry)
+    {
+        if (lines.empty())
+            return;
+
+        Line *victim = &lines.front();
+        for (auto &line: lines) {
+            if (line.valid && line.level == level && line.tag == tag &&
+                    line.root == root) {
+                victim = &line;
+                break;
+            }
+            if (!line.valid) {
+                if (victim->valid)
+                    victim = &line;
+            } else if (victim->valid && line.lastUsed < victim->lastUsed) {
+                victim = &line;
+            }
+        }
+
+        victim->valid = true;
+        victim->root = root;
+        victim->level = level;
+        victim->tag = tag;
+        victim->lastUsed = ++useCount;
+        victim->entry = entry;
+    }
+
+    void
+    flush()
+    {
+        for (auto &line: lines)
+            line.valid = false;
+    }
+};
+
+} // namespace gem5
+
+#endif // __ARCH_GENERIC_WALK_CACHE_HH__
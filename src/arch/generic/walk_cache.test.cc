@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "arch/generic/walk_cache.hh"
+
+using namespace gem5;
+
+TEST(WalkCache, Disabled)
+{
+    WalkCache cache(0);
+    ASSERT_FALSE(cache.enabled());
+    cache.insert(0x1000, 1, 0x200000, {0x3000, 0});
+    ASSERT_EQ(nullptr, cache.lookup(0x1000, 1, 0x200000));
+}
+
+TEST(WalkCache, Lookup)
+{
+    WalkCache cache(4);
+    ASSERT_TRUE(cache.enabled());
+    ASSERT_EQ(nullptr, cache.lookup(0x1000, 1, 0x200000));
+
+    cache.insert(0x1000, 1, 0x200000, {0x3000, 0x5});
+    const WalkCache::Entry *entry = cache.lookup(0x1000, 1, 0x200000);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(0x3000, entry->table);
+    EXPECT_EQ(0x5, entry->attrs);
+
+    // The root, level and tag all have to match.
+    EXPECT_EQ(nullptr, cache.lookup(0x2000, 1, 0x200000));
+    EXPECT_EQ(nullptr, cache.lookup(0x1000, 2, 0x200000));
+    EXPECT_EQ(nullptr, cache.lookup(0x1000, 1, 0x400000));
+
+    // Inserting the same entry again replaces it.
+    cache.insert(0x1000, 1, 0x200000, {0x4000, 0});
+    entry = cache.lookup(0x1000, 1, 0x200000);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(0x4000, entry->table);
+}
+
+TEST(WalkCache, ReplaceLRU)
+{
+    WalkCache cache(2);
+    cache.insert(0x1000, 1, 0x200000, {0x3000, 0});
+    cache.insert(0x1000, 1, 0x400000, {0x4000, 0});
+    // Make the first entry the most recently used one.
+    ASSERT_NE(nullptr, cache.lookup(0x1000, 1, 0x200000));
+
+    cache.insert(0x1000, 1, 0x600000, {0x5000, 0});
+    EXPECT_NE(nullptr, cache.lookup(0x1000, 1, 0x200000));
+    EXPECT_EQ(nullptr, cache.lookup(0x1000, 1, 0x400000));
+    EXPECT_NE(nullptr, cache.lookup(0x1000, 1, 0x600000));
+}
+
+TEST(WalkCache, Flush)
+{
+    WalkCache cache(2);
+    cache.insert(0x1000, 1, 0x200000, {0x3000, 0});
+    cache.insert(0x1000, 2, 0x40000000, {0x4000, 0});
+    cache.flush();
+    EXPECT_EQ(nullptr, cache.lookup(0x1000, 1, 0x200000));
+    EXPECT_EQ(nullptr, cache.lookup(0x1000, 2, 0x40000000));
+}
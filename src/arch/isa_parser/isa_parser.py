@@ -263,6 +263,9 @@ class NoFormat(object):
 # decoder.cc).  The exec_output attribute  is the string of code for the
 # exec.cc file.  The has_decode_default attribute is used in the decode block
 # to allow explicit default clauses to override default default clauses.
+# The decode_cases attribute collects the DecodeCase objects of the
+# statements in a decode block, which are needed to emit the block as a
+# lookup table.  It is None if the block can only be emitted as a switch.
 
 
 class GenCode(object):
@@ -275,6 +278,7 @@ class GenCode(object):
         exec_output="",
         decode_block="",
         has_decode_default=False,
+        decode_cases=(),
     ):
         self.parser = parser
         self.header_output = header_output
@@ -282,6 +286,7 @@ class GenCode(object):
         self.exec_output = exec_output
         self.decode_block = decode_block
         self.has_decode_default = has_decode_default
+        self.decode_cases = decode_cases
 
     # Write these code chunks out to the filesystem.  They will be properly
     # interwoven by the write_top_level_files().
@@ -298,6 +303,10 @@ class GenCode(object):
     # Override '+' operator: generate a new GenCode object that
     # concatenates all the individual strings in the operands.
     def __add__(self, other):
+        if self.decode_cases is None or other.decode_cases is None:
+            decode_cases = None
+        else:
+            decode_cases = self.decode_cases + other.decode_cases
         return GenCode(
             self.parser,
             self.header_output + other.header_output,
@@ -305,6 +314,7 @@ class GenCode(object):
             self.exec_output + other.exec_output,
             self.decode_block + other.decode_block,
             self.has_decode_default or other.has_decode_default,
+            decode_cases,
         )
 
     # Prepend a string (typically a comment) to all the strings.
@@ -320,6 +330,18 @@ class GenCode(object):
         self.decode_block = pre + indent(self.decode_block) + post
 
 
+# A DecodeCase is one statement of a decode block: the values it matches
+# (None for the default case) and the decoding code to run for them.  When
+# the block is emitted as a lookup table, the code is moved into a decoder
+# method of its own, which is only done once even if the case is shared by
+# several blocks (as default defaults are).
+class DecodeCase(object):
+    def __init__(self, labels, code):
+        self.labels = labels
+        self.code = code
+        self.node = None
+
+
 #####################################################################
 #
 #                      Bitfield Operator Support
@@ -512,10 +534,15 @@ class InstObjParams(object):
 
 
 class ISAParser(Grammar):
-    def __init__(self, output_dir):
+    def __init__(self, output_dir, decode_tables=False):
         super().__init__()
         self.output_dir = output_dir
 
+        # Emit decode blocks as lookup tables instead of switch statements
+        # where possible (see decode_table()).
+        self.decode_tables = decode_tables
+        self.decode_nodes = 0
+
         self.filename = None  # for output file watermarking/scaremongering
 
         # variable to hold templates
@@ -547,6 +574,10 @@ class ISAParser(Grammar):
         # The default case stack.
         self.defaultStack = Stack(None)
 
+        # The widths of the unsigned bitfields, which bound the values a
+        # decode block can select on.
+        self.bitfieldWidths = {}
+
         # Stack that tracks current file and line number.  Each
         # element is a tuple (filename, lineno) that records the
         # *current* filename and the line number in the *previous*
@@ -1102,6 +1133,9 @@ del wrap
         expr = "bits(machInst, %2d, %2d)" % (t[6], t[8])
         if t[2] == "signed":
             expr = "sext<%d>(%s)" % (t[6] - t[8] + 1, expr)
+            self.bitfieldWidths.pop(t[4], None)
+        else:
+            self.bitfieldWidths[t[4]] = t[6] - t[8] + 1
         hash_define = f"#undef {t[4]}\n#define {t[4]}\t{expr}\n"
         GenCode(self, header_output=hash_define).emit()
 
@@ -1111,6 +1145,9 @@ del wrap
         expr = "bits(machInst, %2d, %2d)" % (t[6], t[6])
         if t[2] == "signed":
             expr = "sext<%d>(%s)" % (1, expr)
+            self.bitfieldWidths.pop(t[4], None)
+        else:
+            self.bitfieldWidths[t[4]] = 1
         hash_define = f"#undef {t[4]}\n#define {t[4]}\t{expr}\n"
         GenCode(self, header_output=hash_define).emit()
 
@@ -1122,6 +1159,7 @@ del wrap
                 t.lineno(1), "error: structure bitfields are always unsigned."
             )
         expr = f"machInst.{t[5]}"
+        self.bitfieldWidths.pop(t[4], None)
         hash_define = f"#undef {t[4]}\n#define {t[4]}\t{expr}\n"
         GenCode(self, header_output=hash_define).emit()
 
@@ -1248,7 +1286,13 @@ StaticInstPtr
         # default statement in decode_stmt_list
         if not codeObj.has_decode_default:
             codeObj += default_defaults
-        codeObj.wrap_decode_block("switch (%s) {\n" % t[2], "}\n")
+        table = None
+        if self.decode_tables and codeObj.decode_cases is not None:
+            table = self.decode_table(t[2], codeObj.decode_cases)
+        if table is None:
+            codeObj.wrap_decode_block("switch (%s) {\n" % t[2], "}\n")
+        else:
+            codeObj.decode_block = table
         t[0] = codeObj
 
     # The opt_default statement serves only to push the "default
@@ -1267,6 +1311,7 @@ StaticInstPtr
         "opt_default : DEFAULT inst"
         # push the new default
         codeObj = t[2]
+        codeObj.decode_cases = (DecodeCase([None], codeObj.decode_block),)
         codeObj.wrap_decode_block("\ndefault:\n", "break;\n")
         self.defaultStack.push(codeObj)
         # no meaningful value returned
@@ -1298,9 +1343,16 @@ StaticInstPtr
     # instruction definition.  Handling them as part of the grammar
     # makes it easy to keep them in the right place with respect to
     # the code generated by the other statements.
+    #
+    # Decode blocks containing directives are never emitted as lookup
+    # tables, but the decoder methods of their nested tables are, so the
+    # directives are also written out right away to keep the methods
+    # inside them.
     def p_decode_stmt_cpp(self, t):
         "decode_stmt : CPPDIRECTIVE"
-        t[0] = GenCode(self, t[1], t[1], t[1], t[1])
+        if self.decode_tables:
+            self.get_file("decode_block").write(t[1])
+        t[0] = GenCode(self, t[1], t[1], t[1], t[1], decode_cases=None)
 
     # A format block 'format <foo> { ... }' sets the default
     # instruction format used to handle instruction definitions inside
@@ -1333,12 +1385,13 @@ StaticInstPtr
         "decode_stmt : case_list COLON decode_block"
         case_list = t[1]
         codeObj = t[3]
+        codeObj.decode_cases = (DecodeCase(case_list, codeObj.decode_block),)
         # just wrap the decoding code from the block as a case in the
         # outer switch statement.
         codeObj.wrap_decode_block(
-            f"\n{''.join(case_list)}\n", "GEM5_UNREACHABLE;\n"
+            f"\n{self.prep_case_labels(case_list)}\n", "GEM5_UNREACHABLE;\n"
         )
-        codeObj.has_decode_default = case_list == ["default:"]
+        codeObj.has_decode_default = case_list == [None]
         t[0] = codeObj
 
     # Instruction definition (finally!).
@@ -1346,17 +1399,21 @@ StaticInstPtr
         "decode_stmt : case_list COLON inst SEMI"
         case_list = t[1]
         codeObj = t[3]
-        codeObj.wrap_decode_block(f"\n{''.join(case_list)}", "break;\n")
-        codeObj.has_decode_default = case_list == ["default:"]
+        codeObj.decode_cases = (DecodeCase(case_list, codeObj.decode_block),)
+        codeObj.wrap_decode_block(
+            f"\n{self.prep_case_labels(case_list)}", "break;\n"
+        )
+        codeObj.has_decode_default = case_list == [None]
         t[0] = codeObj
 
     # The constant list for a decode case label must be non-empty, and must
     # either be the keyword 'default', or made up of one or more
     # comma-separated integer literals or strings which evaluate to
-    # constants when compiled as C++.
+    # constants when compiled as C++.  The list holds the literals, with
+    # None standing for 'default'.
     def p_case_list_0(self, t):
         "case_list : DEFAULT"
-        t[0] = ["default:"]
+        t[0] = [None]
 
     def prep_int_lit_case_label(self, lit):
         if lit >= 2**32:
@@ -1367,23 +1424,134 @@ StaticInstPtr
     def prep_str_lit_case_label(self, lit):
         return f"case {lit}: "
 
+    def prep_case_labels(self, case_list):
+        if case_list == [None]:
+            return "default:"
+        return "".join(
+            self.prep_int_lit_case_label(lit)
+            if isinstance(lit, int)
+            else self.prep_str_lit_case_label(lit)
+            for lit in case_list
+        )
+
+    # Decode blocks which select between enough integer literals, spread
+    # over a small enough range, can be emitted as lookup tables instead
+    # of switch statements.  The code of each case is moved into a decoder
+    # method of its own, Decoder::decodeNode<N>(), and the block becomes
+    # an index table, which maps the field value to the case, and a table
+    # of pointers to the case methods.  This splits the huge decodeInst()
+    # into many small functions, which the compiler handles much faster,
+    # at the cost of one indirect call per table and some code size.
+    decode_table_min_cases = 3
+    decode_table_max_size = 1024
+    decode_table_max_sparsity = 16
+
+    decode_node_template = """
+template <>
+gem5::StaticInstPtr
+gem5::%(isa_name)s::Decoder::decodeNode<%(node)d>(
+        gem5::%(isa_name)s::ExtMachInst machInst)
+{
+    using namespace %(namespace)s;
+%(code)s
+    GEM5_UNREACHABLE;
+}
+"""
+
+    def decode_node(self, case):
+        """Return a pointer to the decoder method of a decode case, which
+        is emitted the first time it is needed."""
+        if case.node is None:
+            case.node = self.decode_nodes
+            self.decode_nodes += 1
+            code = self.decode_node_template % {
+                "isa_name": self.isa_name,
+                "namespace": self.namespace,
+                "node": case.node,
+                "code": indent(indent(case.code)),
+            }
+            self.get_file("decode_block").write(code)
+        return "&Decoder::decodeNode<%d>" % case.node
+
+    def decode_table(self, field, cases):
+        """Return the code to decode a block as a lookup table, or None if
+        the block should be emitted as a switch."""
+        index = {}
+        default = None
+        for case in cases:
+            if case.labels == [None]:
+                default = case
+                continue
+            for label in case.labels:
+                if not isinstance(label, int):
+                    return None
+                index.setdefault(label, case)
+
+        if default is None or len(index) < self.decode_table_min_cases:
+            return None
+
+        # An unsigned bitfield can't have values outside the table, so it
+        # doesn't need to be bounds checked.
+        width = self.bitfieldWidths.get(field)
+        if width is not None and 2**width <= self.decode_table_max_size:
+            base, size, checked = 0, 2**width, False
+        else:
+            base = min(index)
+            size = max(index) - base + 1
+            checked = True
+        if (
+            size > self.decode_table_max_size
+            or size > len(index) * self.decode_table_max_sparsity
+        ):
+            return None
+
+        nodes = [default]
+        for case in cases:
+            if case not in nodes:
+                nodes.append(case)
+        entries = [
+            nodes.index(index.get(base + i, default)) for i in range(size)
+        ]
+        index_type = "uint8_t" if len(nodes) <= 256 else "uint16_t"
+
+        code = "using DecodeNode = StaticInstPtr (Decoder::*)(ExtMachInst);\n"
+        code += "static constexpr DecodeNode nodes[] = {\n"
+        for node in nodes:
+            code += "    %s,\n" % self.decode_node(node)
+        code += "};\n"
+        code += "static constexpr %s index[] = {\n" % index_type
+        for i in range(0, size, 16):
+            row = ", ".join("%d" % entry for entry in entries[i : i + 16])
+            code += "    %s,\n" % row
+        code += "};\n"
+        if checked:
+            code += "const uint64_t value = (uint64_t)(%s) - %#xULL;\n" % (
+                field,
+                base % 2**64,
+            )
+            node = "value < %d ? index[value] : 0" % size
+        else:
+            node = "index[%s]" % field
+        code += "return (this->*nodes[%s])(machInst);\n" % node
+        return "{\n" + indent(code) + "}\n"
+
     def p_case_list_1(self, t):
         "case_list : INTLIT"
-        t[0] = [self.prep_int_lit_case_label(t[1])]
+        t[0] = [t[1]]
 
     def p_case_list_2(self, t):
         "case_list : STRLIT"
-        t[0] = [self.prep_str_lit_case_label(t[1])]
+        t[0] = [t[1]]
 
     def p_case_list_3(self, t):
         "case_list : case_list COMMA INTLIT"
         t[0] = t[1]
-        t[0].append(self.prep_int_lit_case_label(t[3]))
+        t[0].append(t[3])
 
     def p_case_list_4(self, t):
         "case_list : case_list COMMA STRLIT"
         t[0] = t[1]
-        t[0].append(self.prep_str_lit_case_label(t[3]))
+        t[0].append(t[3])
 
     # Define an instruction using the current instruction format
     # (specified by an enclosing format block).
@@ -68,11 +68,17 @@ class Decoder : public InstDecoder
 
   protected:
     /// A cache of decoded instruction objects.
-    static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
+    static thread_local GenericISA::BasicDecodeCache<Decoder, ExtMachInst>
+        defaultCache;
     friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
 
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
+    /// Decode the cases of the decode blocks which the ISA parser emits
+    /// as lookup tables, one specialization per case.
+    template <int Node>
+    StaticInstPtr decodeNode(ExtMachInst mach_inst);
+
     /// Decode a machine instruction.
     /// @param mach_inst The binary instruction to decode.
     /// @retval A pointer to the corresponding StaticInst object.
@@ -34,7 +34,8 @@ namespace gem5
 namespace PowerISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
+thread_local GenericISA::BasicDecodeCache<Decoder, ExtMachInst>
+    Decoder::defaultCache;
 
 } // namespace PowerISA
 } // namespace gem5
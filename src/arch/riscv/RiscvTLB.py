@@ -45,6 +45,11 @@ class RiscvPagetableWalker(ClockedObject):
     num_squash_per_cycle = Param.Unsigned(
         4, "Number of outstanding walks that can be squashed per cycle"
     )
+    walk_cache_size = Param.Unsigned(
+        0,
+        "Number of non-leaf page table entries cached by the walker "
+        "(0 disables the cache)",
+    )
     # Grab the pma_checker from the MMU
     pma_checker = Param.PMAChecker(Parent.any, "PMA Checker")
     pmp = Param.PMP(Parent.any, "PMP")
@@ -38,6 +38,9 @@ namespace gem5
 namespace RiscvISA
 {
 
+thread_local GenericISA::BasicDecodeCache<Decoder, ExtMachInst>
+    Decoder::defaultCache;
+
 void Decoder::reset()
 {
     aligned = true;
@@ -86,9 +89,7 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     DPRINTF(Decode, "Decoding instruction 0x%08x at address %#x\n",
             mach_inst.instBits, addr);
 
-    StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
-        si = decodeInst(mach_inst);
+    StaticInstPtr si = defaultCache.decode(this, mach_inst, addr);
 
     DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
             si->getName(), mach_inst);
@@ -50,7 +50,6 @@ namespace RiscvISA
 class Decoder : public InstDecoder
 {
   private:
-    decode_cache::InstMap<ExtMachInst> instMap;
     bool aligned;
     bool mid;
 
@@ -61,6 +60,17 @@ class Decoder : public InstDecoder
 
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
+    /// Decode the cases of the decode blocks which the ISA parser emits
+    /// as lookup tables, one specialization per case.
+    template <int Node>
+    StaticInstPtr decodeNode(ExtMachInst mach_inst);
+
+    /// A cache of decoded instruction objects, shared by the decoders
+    /// which run in the same thread.
+    static thread_local GenericISA::BasicDecodeCache<Decoder, ExtMachInst>
+        defaultCache;
+    friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
+
     /// Decode a machine instruction.
     /// @param mach_inst The binary instruction to decode.
     /// @retval A pointer to the corresponding StaticInst object.
@@ -31,6 +31,12 @@
 #ifndef __ARCH_RISCV_FP_INST_HH__
 #define __ARCH_RISCV_FP_INST_HH__
 
+#include <softfloat.h>
+
+#include "base/fenv.hh"
+#include "base/host_fp.hh"
+#include "base/types.hh"
+
 #define RM_REQUIRED                                                         \
         uint_fast8_t rm = ROUND_MODE;                                       \
         uint_fast8_t frm = xc->readMiscReg(MISCREG_FRM);                    \
@@ -40,4 +46,187 @@
             return std::make_shared<IllegalInstFault>("RM fault", machInst);\
         softfloat_roundingMode = rm;                                        \
 
+namespace gem5
+{
+
+namespace RiscvISA
+{
+
+/*
+ * Versions of the basic single and double precision softfloat operations
+ * which try the host FPU first (see base/host_fp.hh). They return the same
+ * results, update softfloat_exceptionFlags the same way and round
+ * according to softfloat_roundingMode. Rounding to nearest with ties to
+ * max magnitude isn't supported by host_fp and is always left to softfloat.
+ */
+
+static inline float hostFloat(float32_t f) { return bitsToFloat32(f.v); }
+static inline double hostFloat(float64_t f) { return bitsToFloat64(f.v); }
+
+static inline float32_t softFloat(float f) { return {floatToBits32(f)}; }
+static inline float64_t softFloat(double f) { return {floatToBits64(f)}; }
+
+static inline bool
+hostRoundingMode(RoundingMode &rm)
+{
+    switch (softfloat_roundingMode) {
+      case softfloat_round_near_even:
+        rm = RoundingMode::ToNearest;
+        return true;
+      case softfloat_round_minMag:
+        rm = RoundingMode::TowardZero;
+        return true;
+      case softfloat_round_min:
+        rm = RoundingMode::Downward;
+        return true;
+      case softfloat_round_max:
+        rm = RoundingMode::Upward;
+        return true;
+      default:
+        return false;
+    }
+}
+
+template <typename Host>
+static inline auto
+hostResult(Host value, bool inexact)
+{
+    if (inexact)
+        softfloat_exceptionFlags |= softfloat_flag_inexact;
+    return softFloat(value);
+}
+
+static inline float32_t
+fpAdd(float32_t a, float32_t b)
+{
+    RoundingMode rm;
+    float value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::add(hostFloat(a), hostFloat(b), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f32_add(a, b);
+}
+
+static inline float64_t
+fpAdd(float64_t a, float64_t b)
+{
+    RoundingMode rm;
+    double value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::add(hostFloat(a), hostFloat(b), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f64_add(a, b);
+}
+
+static inline float32_t
+fpSub(float32_t a, float32_t b)
+{
+    RoundingMode rm;
+    float value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::add(hostFloat(a), -hostFloat(b), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f32_sub(a, b);
+}
+
+static inline float64_t
+fpSub(float64_t a, float64_t b)
+{
+    RoundingMode rm;
+    double value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::add(hostFloat(a), -hostFloat(b), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f64_sub(a, b);
+}
+
+static inline float32_t
+fpMul(float32_t a, float32_t b)
+{
+    RoundingMode rm;
+    float value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::mul(hostFloat(a), hostFloat(b), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f32_mul(a, b);
+}
+
+static inline float64_t
+fpMul(float64_t a, float64_t b)
+{
+    RoundingMode rm;
+    double value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::mul(hostFloat(a), hostFloat(b), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f64_mul(a, b);
+}
+
+static inline float32_t
+fpDiv(float32_t a, float32_t b)
+{
+    RoundingMode rm;
+    float value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::div(hostFloat(a), hostFloat(b), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f32_div(a, b);
+}
+
+static inline float64_t
+fpDiv(float64_t a, float64_t b)
+{
+    RoundingMode rm;
+    double value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::div(hostFloat(a), hostFloat(b), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f64_div(a, b);
+}
+
+static inline float32_t
+fpSqrt(float32_t a)
+{
+    RoundingMode rm;
+    float value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::sqrt(hostFloat(a), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f32_sqrt(a);
+}
+
+static inline float64_t
+fpSqrt(float64_t a)
+{
+    RoundingMode rm;
+    double value;
+    bool inexact;
+    if (hostRoundingMode(rm) &&
+            host_fp::sqrt(hostFloat(a), rm, value, inexact)) {
+        return hostResult(value, inexact);
+    }
+    return f64_sqrt(a);
+}
+
+} // namespace RiscvISA
+} // namespace gem5
+
 #endif // __ARCH_RISCV_FP_INST_HH__
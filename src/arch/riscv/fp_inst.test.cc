@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "arch/riscv/fp_inst.hh"
+#include "base/gtest/host_fp_operands.hh"
+
+using namespace gem5;
+using namespace RiscvISA;
+
+namespace
+{
+
+template <typename SoftFloat, typename FastOp, typename SoftOp>
+void
+checkBinary(SoftFloat a, SoftFloat b, FastOp fast_op, SoftOp soft_op)
+{
+    for (uint_fast8_t rm = softfloat_round_near_even;
+            rm <= softfloat_round_near_maxMag; rm++) {
+        softfloat_roundingMode = rm;
+
+        softfloat_exceptionFlags = 0;
+        SoftFloat expected = soft_op(a, b);
+        uint_fast8_t expected_flags = softfloat_exceptionFlags;
+
+        softfloat_exceptionFlags = 0;
+        SoftFloat result = fast_op(a, b);
+        uint_fast8_t flags = softfloat_exceptionFlags;
+
+        ASSERT_EQ(expected.v, result.v) << std::hex << "a: " << a.v <<
+            " b: " << b.v << " rm: " << (int)rm;
+        ASSERT_EQ(expected_flags, flags) << std::hex << "a: " << a.v <<
+            " b: " << b.v << " rm: " << (int)rm;
+    }
+    softfloat_roundingMode = softfloat_round_near_even;
+}
+
+template <typename SoftFloat, typename FastOp, typename SoftOp>
+void
+checkUnary(SoftFloat a, FastOp fast_op, SoftOp soft_op)
+{
+    checkBinary(a, a,
+            [&](SoftFloat x, SoftFloat) { return fast_op(x); },
+            [&](SoftFloat x, SoftFloat) { return soft_op(x); });
+}
+
+} // anonymous namespace
+
+TEST(RiscvHostFp, F32)
+{
+    host_fp_operands::forPairs<uint32_t>(100000,
+        [](uint32_t a_bits, uint32_t b_bits) {
+            float32_t a{a_bits}, b{b_bits};
+            checkBinary(a, b, [](auto x, auto y) { return fpAdd(x, y); },
+                    f32_add);
+            checkBinary(a, b, [](auto x, auto y) { return fpSub(x, y); },
+                    f32_sub);
+            checkBinary(a, b, [](auto x, auto y) { return fpMul(x, y); },
+                    f32_mul);
+            checkBinary(a, b, [](auto x, auto y) { return fpDiv(x, y); },
+                    f32_div);
+            checkUnary(a, [](auto x) { return fpSqrt(x); }, f32_sqrt);
+        });
+}
+
+TEST(RiscvHostFp, F64)
+{
+    host_fp_operands::forPairs<uint64_t>(100000,
+        [](uint64_t a_bits, uint64_t b_bits) {
+            float64_t a{a_bits}, b{b_bits};
+            checkBinary(a, b, [](auto x, auto y) { return fpAdd(x, y); },
+                    f64_add);
+            checkBinary(a, b, [](auto x, auto y) { return fpSub(x, y); },
+                    f64_sub);
+            checkBinary(a, b, [](auto x, auto y) { return fpMul(x, y); },
+                    f64_mul);
+            checkBinary(a, b, [](auto x, auto y) { return fpDiv(x, y); },
+                    f64_div);
+            checkUnary(a, [](auto x) { return fpSqrt(x); }, f64_sqrt);
+        });
+}
+
+TEST(RiscvHostFp, RoundToMaxMagnitude)
+{
+    // 1 + 2^-24 is halfway between two single precision values. Rounding
+    // to nearest with ties to max magnitude, which the host FPU doesn't
+    // have, rounds it up instead of to the even one.
+    softfloat_roundingMode = softfloat_round_near_maxMag;
+    softfloat_exceptionFlags = 0;
+    float32_t sum = fpAdd(float32_t{0x3f800000}, float32_t{0x33800000});
+    EXPECT_EQ(0x3f800001, sum.v);
+    EXPECT_EQ(softfloat_flag_inexact, softfloat_exceptionFlags);
+    softfloat_roundingMode = softfloat_round_near_even;
+}
@@ -228,10 +228,44 @@ Walker::startWalkWrapper()
         else
             currState = NULL;
     }
+    // Walks which were waiting for another one to finish may miss in the
+    // page table walker only because they were queued behind it. Finish
+    // those which now hit in the TLB without walking the page table.
+    while (currState && !currState->wasStarted() &&
+            !currState->translation->squashed() &&
+            currState->finishFromTLB()) {
+        currStates.pop_front();
+        stats.coalescedWalks++;
+        delete currState;
+
+        if (currStates.size())
+            currState = currStates.front();
+        else
+            currState = NULL;
+    }
     if (currState && !currState->wasStarted())
         currState->startWalk();
 }
 
+bool
+Walker::WalkerState::finishFromTLB()
+{
+    Addr vaddr = Addr(sext<VADDR_BITS>(req->getVaddr()));
+    TlbEntry *e = walker->tlb->lookup(vaddr, satp.asid, mode, true);
+    // Writes to clean pages and permission faults are handled by the walk.
+    if (!e || (mode == BaseMMU::Write && !e->pte.w))
+        return false;
+    if (walker->tlb->checkPermissions(status, pmode, vaddr, mode,
+                                      e->pte) != NoFault)
+        return false;
+
+    DPRINTF(PageTableWalker, "Finishing queued walk for address %#x "
+            "from the TLB\n", vaddr);
+    Fault fault = translateWithTLB();
+    translation->finish(fault, req, tc, mode);
+    return true;
+}
+
 Fault
 Walker::WalkerState::startWalk()
 {
@@ -388,6 +422,13 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
                     Addr idx = (entry.vaddr >> shift) & LEVEL_MASK;
                     nextRead = (pte.ppn << PageShift) + (idx * sizeof(pte));
                     nextState = Translate;
+                    if (!functional && walker->walkCache.enabled()) {
+                        WalkCache::Entry cached;
+                        cached.table = pte.ppn << PageShift;
+                        walker->walkCache.insert(satp.ppn << PageShift,
+                            level + 1, mbits(entry.vaddr, 63,
+                                             shift + LEVEL_BITS), cached);
+                    }
                 }
             }
         }
@@ -458,6 +499,26 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     Addr topAddr = (satp.ppn << PageShift) + (idx * sizeof(PTESv39));
     level = 2;
 
+    if (!functional && walker->walkCache.enabled()) {
+        // Start with the table pointed to by the deepest cached entry.
+        for (int cached_level = 1; cached_level <= 2; cached_level++) {
+            const WalkCache::Entry *cached = walker->walkCache.lookup(
+                satp.ppn << PageShift, cached_level,
+                mbits(vaddr, 63, PageShift + LEVEL_BITS * cached_level));
+            if (cached) {
+                level = cached_level - 1;
+                shift = PageShift + LEVEL_BITS * level;
+                idx = (vaddr >> shift) & LEVEL_MASK;
+                topAddr = cached->table + (idx * sizeof(PTESv39));
+                break;
+            }
+        }
+        if (level < 2)
+            walker->stats.walkCacheHits++;
+        else
+            walker->stats.walkCacheMisses++;
+    }
+
     DPRINTF(PageTableWalker, "Performing table walk for address %#x\n", vaddr);
     DPRINTF(PageTableWalker, "Loading level%d PTE from %#x\n", level, topAddr);
 
@@ -520,16 +581,7 @@ Walker::WalkerState::recvPacket(PacketPtr pkt)
              * permissions violations, so we'll need the return value as
              * well.
              */
-            Addr vaddr = req->getVaddr();
-            vaddr = Addr(sext<VADDR_BITS>(vaddr));
-            Addr paddr = walker->tlb->translateWithTLB(vaddr, satp.asid, mode);
-            req->setPaddr(paddr);
-            walker->pma->check(req);
-
-            // do pmp check if any checking condition is met.
-            // timingFault will be NoFault if pmp checks are
-            // passed, otherwise an address fault will be returned.
-            timingFault = walker->pmp->pmpCheck(req, mode, pmode, tc);
+            timingFault = translateWithTLB();
 
             // Let the CPU continue.
             translation->finish(timingFault, req, tc, mode);
@@ -543,6 +595,21 @@ Walker::WalkerState::recvPacket(PacketPtr pkt)
     return false;
 }
 
+Fault
+Walker::WalkerState::translateWithTLB()
+{
+    Addr vaddr = req->getVaddr();
+    vaddr = Addr(sext<VADDR_BITS>(vaddr));
+    Addr paddr = walker->tlb->translateWithTLB(vaddr, satp.asid, mode);
+    req->setPaddr(paddr);
+    walker->pma->check(req);
+
+    // do pmp check if any checking condition is met.
+    // The result will be NoFault if pmp checks are
+    // passed, otherwise an address fault will be returned.
+    return walker->pmp->pmpCheck(req, mode, pmode, tc);
+}
+
 void
 Walker::WalkerState::sendPackets()
 {
@@ -613,6 +680,17 @@ Walker::WalkerState::retry()
     sendPackets();
 }
 
+Walker::WalkerStats::WalkerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(walkCacheHits, statistics::units::Count::get(),
+               "Number of walks which started below the root table"),
+      ADD_STAT(walkCacheMisses, statistics::units::Count::get(),
+               "Number of walks which missed in the walk cache"),
+      ADD_STAT(coalescedWalks, statistics::units::Count::get(),
+               "Number of queued walks finished by an earlier walk")
+{
+}
+
 Fault
 Walker::WalkerState::pageFault(bool present)
 {
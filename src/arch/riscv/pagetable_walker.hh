@@ -42,10 +42,12 @@
 #include <vector>
 
 #include "arch/generic/mmu.hh"
+#include "arch/generic/walk_cache.hh"
 #include "arch/riscv/pagetable.hh"
 #include "arch/riscv/pma_checker.hh"
 #include "arch/riscv/pmp.hh"
 #include "arch/riscv/tlb.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/RiscvPagetableWalker.hh"
@@ -130,6 +132,7 @@ namespace RiscvISA
             Fault startWalk();
             Fault startFunctional(Addr &addr, unsigned &logBytes);
             bool recvPacket(PacketPtr pkt);
+            bool finishFromTLB();
             unsigned numInflight() const;
             bool isRetrying();
             bool wasStarted();
@@ -140,6 +143,7 @@ namespace RiscvISA
 
           private:
             void setupWalk(Addr vaddr);
+            Fault translateWithTLB();
             Fault stepWalk(PacketPtr &write);
             void sendPackets();
             void endWalk();
@@ -180,6 +184,9 @@ namespace RiscvISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        // Cache of the non-leaf entries of the page tables.
+        WalkCache walkCache;
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -193,6 +200,15 @@ namespace RiscvISA
         void recvReqRetry();
         bool sendTiming(WalkerState * sendingState, PacketPtr pkt);
 
+        struct WalkerStats : public statistics::Group
+        {
+            WalkerStats(statistics::Group *parent);
+
+            statistics::Scalar walkCacheHits;
+            statistics::Scalar walkCacheMisses;
+            statistics::Scalar coalescedWalks;
+        } stats;
+
       public:
 
         void setTLB(TLB * _tlb)
@@ -200,6 +216,11 @@ namespace RiscvISA
             tlb = _tlb;
         }
 
+        void flushWalkCache()
+        {
+            walkCache.flush();
+        }
+
         using Params = RiscvPagetableWalkerParams;
 
         Walker(const Params &params) :
@@ -209,7 +230,9 @@ namespace RiscvISA
             pmp(params.pmp),
             requestorId(sys->getRequestorId(this)),
             numSquashable(params.num_squash_per_cycle),
-            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
+            walkCache(params.walk_cache_size),
+            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name()),
+            stats(this)
         {
         }
     };
@@ -193,6 +193,7 @@ TLB::demapPage(Addr vpn, uint64_t asid)
                 }
             }
         }
+        walker->flushWalkCache();
     }
 }
 
@@ -204,6 +205,7 @@ TLB::flushAll()
         if (tlb[i].trieHandle)
             remove(i);
     }
+    walker->flushWalkCache();
 }
 
 void
@@ -450,7 +452,7 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc,
     }
     else {
         Process *process = tc->getProcessPtr();
-        const auto *pte = process->pTable->lookup(vaddr);
+        auto pte = process->pTable->lookup(vaddr);
 
         if (!pte && mode != BaseMMU::Execute) {
             // Check if we just need to grow the stack.
@@ -34,7 +34,8 @@ namespace gem5
 namespace SparcISA
 {
 
-GenericISA::BasicDecodeCache<Decoder, ExtMachInst> Decoder::defaultCache;
+thread_local GenericISA::BasicDecodeCache<Decoder, ExtMachInst>
+    Decoder::defaultCache;
 
 } // namespace SparcISA
 } // namespace gem5
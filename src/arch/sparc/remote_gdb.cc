@@ -169,7 +169,7 @@ RemoteGDB::acc(Addr va, size_t len)
     } else {
         // Check to make sure the first byte is mapped into the processes
         // address space.
-        return context()->getProcessPtr()->pTable->lookup(va) != nullptr;
+        return context()->getProcessPtr()->pTable->lookup(va).has_value();
     }
 }
 
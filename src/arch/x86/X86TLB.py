@@ -50,6 +50,11 @@ class X86PagetableWalker(ClockedObject):
     num_squash_per_cycle = Param.Unsigned(
         4, "Number of outstanding walks that can be squashed per cycle"
     )
+    walk_cache_size = Param.Unsigned(
+        0,
+        "Number of non-leaf page table entries cached by the walker "
+        "(0 disables the cache)",
+    )
 
 
 class X86TLB(BaseTLB):
@@ -69,6 +69,7 @@ Decoder::doResetState()
     if (instBytes->si) {
         return FromCacheState;
     } else {
+        stats.cacheMisses++;
         instBytes->chunks.clear();
         return PrefixState;
     }
@@ -151,6 +152,7 @@ Decoder::doFromCacheState()
     if ((fetchChunk & instBytes->masks[chunkIdx]) !=
             instBytes->chunks[chunkIdx]) {
         DPRINTF(Decoder, "Decode cache miss.\n");
+        stats.cacheConflicts++;
         // The chached chunks didn't match what was fetched. Fall back to the
         // predecoder.
         instBytes->chunks[chunkIdx] = fetchChunk;
@@ -163,6 +165,7 @@ Decoder::doFromCacheState()
         return PrefixState;
     } else if (chunkIdx == instBytes->chunks.size() - 1) {
         // We matched the cache, so use its value.
+        stats.cacheHits++;
         instDone = true;
         offset = instBytes->lastOffset;
         if (offset == sizeof(MachInst))
@@ -671,14 +674,37 @@ Decoder::doImmediateState()
     return nextState;
 }
 
+Decoder::DecoderStats::DecoderStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(cacheHits, statistics::units::Count::get(),
+               "Number of instructions found in the decode cache"),
+      ADD_STAT(cacheMisses, statistics::units::Count::get(),
+               "Number of instructions not in the decode cache"),
+      ADD_STAT(cacheConflicts, statistics::units::Count::get(),
+               "Number of decode cache entries replaced because the "
+               "instruction bytes changed"),
+      ADD_STAT(cacheHitRate, statistics::units::Ratio::get(),
+               "Fraction of instructions found in the decode cache",
+               cacheHits / (cacheHits + cacheMisses + cacheConflicts))
+{
+    cacheHitRate.precision(6);
+}
+
 Decoder::InstBytes Decoder::dummy;
-Decoder::InstCacheMap Decoder::instCacheMap;
+thread_local Decoder::InstCacheMap Decoder::instCacheMap;
 
 StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
     StaticInstPtr si;
 
+    if (!instMap) {
+        auto *&map = instCacheMap[instMapKey];
+        if (!map)
+            map = new decode_cache::InstMap<ExtMachInst>;
+        instMap = map;
+    }
+
     auto iter = instMap->find(mach_inst);
     if (iter != instMap->end()) {
         si = iter->second;
@@ -39,6 +39,7 @@
 #include "arch/x86/types.hh"
 #include "base/bitfield.hh"
 #include "base/logging.hh"
+#include "base/statistics.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
 #include "cpu/decode_cache.hh"
@@ -242,12 +243,22 @@ class Decoder : public InstDecoder
     AddrCacheMap addrCacheMap;
 
     decode_cache::InstMap<ExtMachInst> *instMap = nullptr;
+    /// The mode to look the instruction map up for when it's needed.
+    CacheKey instMapKey = 0;
     typedef std::unordered_map<
             CacheKey, decode_cache::InstMap<ExtMachInst> *> InstCacheMap;
-    static InstCacheMap instCacheMap;
+    /// The instruction maps are shared by the decoders which run in the
+    /// same thread. StaticInsts aren't reference counted atomically, so
+    /// they must not be shared with other event queue threads.
+    static thread_local InstCacheMap instCacheMap;
 
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
+    /// Decode the cases of the decode blocks which the ISA parser emits
+    /// as lookup tables, one specialization per case.
+    template <int Node>
+    StaticInstPtr decodeNode(ExtMachInst mach_inst);
+
     /// Decode a machine instruction.
     /// @param mach_inst The binary instruction to decode.
     /// @retval A pointer to the corresponding StaticInst object.
@@ -255,8 +266,19 @@ class Decoder : public InstDecoder
 
     void process();
 
+    struct DecoderStats : public statistics::Group
+    {
+        DecoderStats(statistics::Group *parent);
+
+        statistics::Scalar cacheHits;
+        statistics::Scalar cacheMisses;
+        statistics::Scalar cacheConflicts;
+        statistics::Formula cacheHitRate;
+    } stats;
+
   public:
-    Decoder(const X86DecoderParams &p) : InstDecoder(p, &fetchChunk)
+    Decoder(const X86DecoderParams &p) :
+        InstDecoder(p, &fetchChunk), stats(this)
     {
         emi.reset();
         emi.mode.cpl = cpl;
@@ -287,13 +309,10 @@ class Decoder : public InstDecoder
             addrCacheMap[m5Reg] = decodePages;
         }
 
-        InstCacheMap::iterator imIter = instCacheMap.find(m5Reg);
-        if (imIter != instCacheMap.end()) {
-            instMap = imIter->second;
-        } else {
-            instMap = new decode_cache::InstMap<ExtMachInst>;
-            instCacheMap[m5Reg] = instMap;
-        }
+        // The instruction map is looked up by the thread which decodes,
+        // which need not be the one which sets up the decoder.
+        instMapKey = m5Reg;
+        instMap = nullptr;
     }
 
     void
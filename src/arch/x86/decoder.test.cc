@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "arch/x86/decoder.hh"
+#include "arch/x86/insts/static_inst.hh"
+#include "arch/x86/pcstate.hh"
+#include "arch/x86/regs/misc.hh"
+#include "params/X86Decoder.hh"
+
+using namespace gem5;
+using namespace gem5::X86ISA;
+
+namespace
+{
+
+/** A byte sequence which decodes to one instruction. */
+using Bytes = std::vector<uint8_t>;
+
+/**
+ * Instructions with the prefixes, opcode maps, ModRM, SIB, displacement
+ * and immediate sizes the decoder handles differently.
+ */
+const std::vector<Bytes> corpus = {
+    {0x90},                                     // nop
+    {0x55},                                     // push rbp
+    {0x48, 0x89, 0xe5},                         // mov rbp, rsp
+    {0x48, 0x83, 0xec, 0x10},                   // sub rsp, 0x10
+    {0x48, 0x8b, 0x44, 0x24, 0x08},             // mov rax, [rsp+8]
+    {0x48, 0x8d, 0x05, 0x78, 0x56, 0x34, 0x12}, // lea rax, [rip+disp]
+    // movabs rax, imm64
+    {0x48, 0xb8, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11},
+    // mov qword [rax+rcx*4+disp32], imm32
+    {0x48, 0xc7, 0x84, 0x88, 0x44, 0x33, 0x22, 0x11,
+     0x78, 0x56, 0x34, 0x12},
+    {0x66, 0x0f, 0x6f, 0xc1},                   // movdqa xmm0, xmm1
+    {0xf3, 0x48, 0xa5},                         // rep movsq
+    {0x0f, 0x1f, 0x44, 0x00, 0x00},             // nop dword [rax+rax]
+    {0x67, 0x8b, 0x00},                         // mov eax, [eax]
+    {0xf0, 0x48, 0x0f, 0xb1, 0x0a},             // lock cmpxchg [rdx], rcx
+    {0x66, 0x0f, 0x38, 0x00, 0xc1},             // pshufb xmm0, xmm1
+    {0x66, 0x0f, 0x3a, 0x0f, 0xc1, 0x08},       // palignr xmm0, xmm1, 8
+    {0xc5, 0xf8, 0x77},                         // vzeroupper
+    {0xe8, 0x00, 0x01, 0x00, 0x00},             // call rel32
+    {0x74, 0x05},                               // je rel8
+    {0x0f, 0x05},                               // syscall
+    {0xc3},                                     // ret
+};
+
+HandyM5Reg
+longMode()
+{
+    HandyM5Reg m5reg = 0;
+    m5reg.mode = LongMode;
+    m5reg.submode = SixtyFourBitMode;
+    m5reg.defOp = 2;
+    m5reg.altOp = 1;
+    m5reg.defAddr = 3;
+    m5reg.altAddr = 2;
+    m5reg.stack = 3;
+    return m5reg;
+}
+
+HandyM5Reg
+protectedMode()
+{
+    HandyM5Reg m5reg = 0;
+    m5reg.mode = LegacyMode;
+    m5reg.submode = ProtectedMode;
+    m5reg.defOp = 2;
+    m5reg.altOp = 1;
+    m5reg.defAddr = 2;
+    m5reg.altAddr = 1;
+    m5reg.stack = 2;
+    return m5reg;
+}
+
+/** The params of a decoder, which have to outlive it. */
+struct DecoderParams
+{
+    X86DecoderParams decoderParams;
+
+    DecoderParams()
+    {
+        decoderParams.name = "decoder";
+        decoderParams.eventq_index = 0;
+        decoderParams.isa = nullptr;
+    }
+};
+
+/** A decoder which is fed from a buffer the way the simple CPUs feed it. */
+class TestDecoder : private DecoderParams, public Decoder
+{
+  private:
+    const HandyM5Reg m5Reg;
+
+  public:
+    TestDecoder(HandyM5Reg m5reg) : Decoder(decoderParams), m5Reg(m5reg)
+    {
+        setM5Reg(m5Reg);
+    }
+
+    /** Decode the instruction at pc, which sets its size and next pc. */
+    StaticInstPtr
+    decodeAt(const Bytes &mem, Addr base, PCState &pc)
+    {
+        reset();
+        Addr fetch_pc = pc.instAddr() & pcMask();
+        while (true) {
+            std::memcpy(moreBytesPtr(), &mem.at(fetch_pc - base),
+                        moreBytesSize());
+            moreBytes(pc, fetch_pc);
+            StaticInstPtr si = decode(pc);
+            if (si)
+                return si;
+            fetch_pc += moreBytesSize();
+        }
+    }
+
+    /** Forget the instructions decoded at each address. */
+    void
+    flushDecodePages()
+    {
+        for (auto &pages : addrCacheMap)
+            delete pages.second;
+        addrCacheMap.clear();
+        setM5Reg(m5Reg);
+    }
+
+    /**
+     * Build the last instruction decoded by the state machine again,
+     * without looking it up.
+     */
+    StaticInstPtr decodeUncached() { return decodeInst(emi); }
+
+    const ExtMachInst &extMachInst() const { return emi; }
+
+    const DecoderStats &decoderStats() const { return stats; }
+};
+
+/** What a decoded instruction looks like to the CPU. */
+struct Decoded
+{
+    ExtMachInst machInst;
+    std::vector<std::string> disassembly;
+    Addr size;
+};
+
+Decoded
+describe(const StaticInstPtr &si, Addr pc, Addr size)
+{
+    Decoded d;
+    d.machInst = static_cast<X86StaticInst *>(si.get())->machInst;
+    d.disassembly.push_back(si->disassemble(pc));
+    if (si->isMacroop()) {
+        StaticInstPtr uop;
+        MicroPC upc = 0;
+        do {
+            uop = si->fetchMicroop(upc++);
+            d.disassembly.push_back(uop->disassemble(pc));
+        } while (!uop->isLastMicroop());
+    }
+    d.size = size;
+    return d;
+}
+
+void
+expectSame(const Decoded &expected, const Decoded &actual, int inst)
+{
+    SCOPED_TRACE(inst);
+    EXPECT_TRUE(expected.machInst == actual.machInst)
+        << "expected " << expected.machInst
+        << "actual " << actual.machInst;
+    EXPECT_EQ(expected.disassembly, actual.disassembly);
+    EXPECT_EQ(expected.size, actual.size);
+}
+
+/**
+ * Decode the corpus from consecutive addresses, so that instructions
+ * straddle fetch chunks, without the decode cache.
+ */
+std::vector<Decoded>
+decodeCorpusUncached(TestDecoder &decoder, const Bytes &mem, Addr base,
+                     Addr start)
+{
+    std::vector<Decoded> decoded;
+    PCState pc(start);
+    for (int i = 0; i < corpus.size(); i++) {
+        decoder.flushDecodePages();
+        decoder.decodeAt(mem, base, pc);
+        StaticInstPtr si = decoder.decodeUncached();
+        decoded.push_back(describe(si, pc.pc(), pc.size()));
+        pc = PCState(pc.npc());
+    }
+    return decoded;
+}
+
+std::vector<Decoded>
+decodeCorpusCached(TestDecoder &decoder, const Bytes &mem, Addr base,
+                   Addr start)
+{
+    std::vector<Decoded> decoded;
+    PCState pc(start);
+    for (int i = 0; i < corpus.size(); i++) {
+        StaticInstPtr si = decoder.decodeAt(mem, base, pc);
+        decoded.push_back(describe(si, pc.pc(), pc.size()));
+        pc = PCState(pc.npc());
+    }
+    return decoded;
+}
+
+/** Lay the corpus out in memory from an address which isn't aligned. */
+Bytes
+layOut(Addr base, Addr start)
+{
+    Bytes mem(start - base);
+    for (const auto &inst : corpus)
+        mem.insert(mem.end(), inst.begin(), inst.end());
+    // Padding for the last fetch.
+    mem.resize(mem.size() + 16, 0x90);
+    return mem;
+}
+
+void
+checkCacheMatchesStateMachine(HandyM5Reg m5reg)
+{
+    const Addr base = 0x400000;
+    const Addr start = base + 3;
+    const Bytes mem = layOut(base, start);
+
+    TestDecoder uncached(m5reg);
+    auto expected = decodeCorpusUncached(uncached, mem, base, start);
+
+    TestDecoder cached(m5reg);
+    // The first pass fills the cache, the second one hits.
+    for (int pass = 0; pass < 2; pass++) {
+        SCOPED_TRACE(pass);
+        auto actual = decodeCorpusCached(cached, mem, base, start);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (int i = 0; i < expected.size(); i++)
+            expectSame(expected[i], actual[i], i);
+    }
+    EXPECT_EQ(corpus.size(), cached.decoderStats().cacheMisses.value());
+    EXPECT_EQ(corpus.size(), cached.decoderStats().cacheHits.value());
+    EXPECT_EQ(0, cached.decoderStats().cacheConflicts.value());
+}
+
+} // anonymous namespace
+
+TEST(X86DecoderTest, CacheMatchesStateMachineLongMode)
+{
+    checkCacheMatchesStateMachine(longMode());
+}
+
+TEST(X86DecoderTest, CacheMatchesStateMachineProtectedMode)
+{
+    checkCacheMatchesStateMachine(protectedMode());
+}
+
+/** Changing the bytes at a cached address decodes the new instruction. */
+TEST(X86DecoderTest, ChangedBytesAreDecodedAgain)
+{
+    const Addr base = 0x400000;
+    const Addr start = base + 5;
+    Bytes mem = layOut(base, start);
+
+    TestDecoder uncached(longMode());
+    TestDecoder cached(longMode());
+
+    // Decode every instruction of the corpus at the same address, after
+    // one which fills the cache, so that each one hits a stale entry
+    // which matches in none, some or all of its chunks.
+    for (int i = 0; i < corpus.size(); i++) {
+        for (int prev = 0; prev < corpus.size(); prev++) {
+            SCOPED_TRACE(prev);
+            for (int inst : {prev, i}) {
+                std::copy(corpus[inst].begin(), corpus[inst].end(),
+                          mem.begin() + (start - base));
+                PCState pc(start);
+                StaticInstPtr si = cached.decodeAt(mem, base, pc);
+                Decoded actual = describe(si, pc.pc(), pc.size());
+
+                pc = PCState(start);
+                uncached.flushDecodePages();
+                uncached.decodeAt(mem, base, pc);
+                Decoded expected = describe(uncached.decodeUncached(),
+                                            pc.pc(), pc.size());
+                expectSame(expected, actual, inst);
+            }
+        }
+    }
+}
+
+/**
+ * The decoder starts every instruction from a cleared ExtMachInst, also
+ * when it finds the instruction in the cache.
+ */
+TEST(X86DecoderTest, CacheHitResetsExtMachInst)
+{
+    const Addr base = 0x400000;
+    const Bytes mem = layOut(base, base);
+
+    TestDecoder decoder(longMode());
+    for (int pass = 0; pass < 2; pass++) {
+        PCState pc(base);
+        for (int i = 0; i < corpus.size(); i++) {
+            decoder.decodeAt(mem, base, pc);
+            pc = PCState(pc.npc());
+        }
+    }
+    ASSERT_EQ(corpus.size(), decoder.decoderStats().cacheHits.value());
+
+    const ExtMachInst &emi = decoder.extMachInst();
+    EXPECT_EQ(0, (uint8_t)emi.legacy);
+    EXPECT_EQ(0, (uint8_t)emi.rex);
+    EXPECT_EQ(0, (uint8_t)emi.vex);
+    EXPECT_EQ(BadOpcode, emi.opcode.type);
+    EXPECT_EQ(0, (uint8_t)emi.opcode.op);
+    EXPECT_EQ(0, (uint8_t)emi.modRM);
+    EXPECT_EQ(0, (uint8_t)emi.sib);
+    EXPECT_EQ(0, emi.immediate);
+    EXPECT_EQ(0, emi.displacement);
+    EXPECT_EQ(0, emi.dispSize);
+}
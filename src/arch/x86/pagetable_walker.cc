@@ -222,10 +222,45 @@ Walker::startWalkWrapper()
         else
             currState = NULL;
     }
+    // Walks which were waiting for another one to finish may miss in the
+    // page table walker only because they were queued behind it. Finish
+    // those which now hit in the TLB without walking the page table.
+    while (currState && !currState->wasStarted() &&
+            !currState->translation->squashed() &&
+            currState->finishFromTLB()) {
+        currStates.pop_front();
+        stats.coalescedWalks++;
+        delete currState;
+
+        if (currStates.size())
+            currState = currStates.front();
+        else
+            currState = NULL;
+    }
     if (currState && !currState->wasStarted())
         currState->startWalk();
 }
 
+bool
+Walker::WalkerState::finishFromTLB()
+{
+    CR3 cr3 = tc->readMiscRegNoEffect(misc_reg::Cr3);
+    CR4 cr4 = tc->readMiscRegNoEffect(misc_reg::Cr4);
+    Addr vpn = walker->tlb->concAddrPcid(
+        req->getVaddr() & ~mask(PageShift), cr4.pcide ? cr3.pcid : 0);
+    if (!walker->tlb->lookup(vpn, false))
+        return false;
+
+    DPRINTF(PageTableWalker, "Finishing queued walk for address %#x "
+            "from the TLB\n", req->getVaddr());
+    bool delayedResponse;
+    Fault fault = walker->tlb->translate(req, tc, NULL, mode,
+                                         delayedResponse, true);
+    assert(!delayedResponse);
+    translation->finish(fault, req, tc, mode);
+    return true;
+}
+
 Fault
 Walker::WalkerState::startWalk()
 {
@@ -311,6 +346,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             break;
         }
         entry.noExec = pte.nx;
+        cacheTableEntry(3, pte);
         nextState = LongPDP;
         break;
       case LongPDP:
@@ -325,6 +361,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             fault = pageFault(pte.p);
             break;
         }
+        cacheTableEntry(2, pte);
         nextState = LongPD;
         break;
       case LongPD:
@@ -342,6 +379,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             // 4 KB page
             entry.logBytes = 12;
             nextRead = mbits(pte, 51, 12) + vaddr.longl1 * dataSize;
+            cacheTableEntry(1, pte);
             nextState = LongPTE;
             break;
         } else {
@@ -547,6 +585,69 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     return fault;
 }
 
+void
+Walker::WalkerState::cacheTableEntry(int level, PageTableEntry pte)
+{
+    walkAttrs.writable = entry.writable;
+    walkAttrs.user = entry.user;
+    walkAttrs.noExec = entry.noExec;
+    walkAttrs.nx = walkAttrs.nx || pte.nx;
+    walkAttrs.pcd = pte.pcd;
+
+    if (functional || !walker->walkCache.enabled())
+        return;
+
+    WalkCache::Entry cached;
+    cached.table = mbits(pte, 51, 12);
+    cached.attrs = walkAttrs;
+    walker->walkCache.insert(walkRoot, level,
+                             mbits(entry.vaddr, 63, PageShift + 9 * level),
+                             cached);
+}
+
+void
+Walker::WalkerState::lookupWalkCache(VAddr vaddr, Addr &topAddr,
+                                     bool &uncacheable)
+{
+    // Look for the deepest cached entry first, it skips the most levels.
+    for (int level = 1; level <= 3; level++) {
+        const WalkCache::Entry *cached = walker->walkCache.lookup(
+            walkRoot, level, mbits(vaddr, 63, PageShift + 9 * level));
+        if (!cached)
+            continue;
+
+        WalkCacheAttrs attrs = cached->attrs;
+        // The fault is raised by the level which has the NX bit set, so
+        // walk the whole page table.
+        if (attrs.nx && mode == BaseMMU::Execute && enableNX)
+            break;
+
+        walker->stats.walkCacheHits++;
+        walkAttrs = attrs;
+        entry.writable = attrs.writable;
+        entry.user = attrs.user;
+        entry.noExec = attrs.noExec;
+        uncacheable = attrs.pcd;
+        switch (level) {
+          case 3:
+            state = LongPDP;
+            topAddr = cached->table + vaddr.longl3 * dataSize;
+            break;
+          case 2:
+            state = LongPD;
+            topAddr = cached->table + vaddr.longl2 * dataSize;
+            break;
+          case 1:
+            state = LongPTE;
+            entry.logBytes = 12;
+            topAddr = cached->table + vaddr.longl1 * dataSize;
+            break;
+        }
+        return;
+    }
+    walker->stats.walkCacheMisses++;
+}
+
 void
 Walker::WalkerState::endWalk()
 {
@@ -565,11 +666,18 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     Efer efer = tc->readMiscRegNoEffect(misc_reg::Efer);
     dataSize = 8;
     Addr topAddr;
+    // PCD can't be used if CR4.PCIDE=1 [sec 2.5
+    // of Intel's Software Developer's manual]
+    bool uncacheable = !cr4.pcide && cr3.pcd;
     if (efer.lma) {
         // Do long mode.
         state = LongPML4;
-        topAddr = (cr3.longPdtb << 12) + addr.longl4 * dataSize;
+        walkRoot = cr3.longPdtb << 12;
+        topAddr = walkRoot + addr.longl4 * dataSize;
         enableNX = efer.nxe;
+        walkAttrs = 0;
+        if (!functional && walker->walkCache.enabled())
+            lookupWalkCache(addr, topAddr, uncacheable);
     } else {
         // We're in some flavor of legacy mode.
         if (cr4.pae) {
@@ -595,10 +703,7 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     entry.vaddr = vaddr;
 
     Request::Flags flags = Request::PHYSICAL;
-
-    // PCD can't be used if CR4.PCIDE=1 [sec 2.5
-    // of Intel's Software Developer's manual]
-    if (!cr4.pcide && cr3.pcd)
+    if (uncacheable)
         flags.set(Request::UNCACHEABLE);
 
     RequestPtr request = std::make_shared<Request>(
@@ -738,6 +843,17 @@ Walker::WalkerState::retry()
     sendPackets();
 }
 
+Walker::WalkerStats::WalkerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(walkCacheHits, statistics::units::Count::get(),
+               "Number of walks which started below the root table"),
+      ADD_STAT(walkCacheMisses, statistics::units::Count::get(),
+               "Number of walks which missed in the walk cache"),
+      ADD_STAT(coalescedWalks, statistics::units::Count::get(),
+               "Number of queued walks finished by an earlier walk")
+{
+}
+
 Fault
 Walker::WalkerState::pageFault(bool present)
 {
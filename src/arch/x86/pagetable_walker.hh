@@ -41,8 +41,11 @@
 #include <vector>
 
 #include "arch/generic/mmu.hh"
+#include "arch/generic/walk_cache.hh"
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
+#include "base/bitunion.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/X86PagetableWalker.hh"
@@ -60,6 +63,16 @@ namespace X86ISA
     class Walker : public ClockedObject
     {
       protected:
+        // Attributes of the levels of a long mode walk down to a cached
+        // page table entry.
+        BitUnion64(WalkCacheAttrs)
+            Bitfield<0> writable;
+            Bitfield<1> user;
+            Bitfield<2> noExec;
+            Bitfield<3> nx;
+            Bitfield<4> pcd;
+        EndBitUnion(WalkCacheAttrs)
+
         // Port for accessing memory
         class WalkerPort : public RequestPort
         {
@@ -115,6 +128,8 @@ namespace X86ISA
             bool retrying;
             bool started;
             bool squashed;
+            Addr walkRoot;
+            WalkCacheAttrs walkAttrs;
           public:
             WalkerState(Walker * _walker, BaseMMU::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -122,7 +137,8 @@ namespace X86ISA
                 nextState(Ready), inflight(0),
                 translation(_translation),
                 functional(_isFunctional), timing(false),
-                retrying(false), started(false), squashed(false)
+                retrying(false), started(false), squashed(false),
+                walkRoot(0), walkAttrs(0)
             {
             }
             void initState(ThreadContext * _tc, BaseMMU::Mode _mode,
@@ -130,6 +146,7 @@ namespace X86ISA
             Fault startWalk();
             Fault startFunctional(Addr &addr, unsigned &logBytes);
             bool recvPacket(PacketPtr pkt);
+            bool finishFromTLB();
             unsigned numInflight() const;
             bool isRetrying();
             bool wasStarted();
@@ -140,6 +157,9 @@ namespace X86ISA
 
           private:
             void setupWalk(Addr vaddr);
+            void lookupWalkCache(VAddr vaddr, Addr &topAddr,
+                                 bool &uncacheable);
+            void cacheTableEntry(int level, PageTableEntry pte);
             Fault stepWalk(PacketPtr &write);
             void sendPackets();
             void endWalk();
@@ -178,6 +198,9 @@ namespace X86ISA
         // The number of outstanding walks that can be squashed per cycle.
         unsigned numSquashable;
 
+        // Cache of the non-leaf entries of long mode page tables.
+        WalkCache walkCache;
+
         // Wrapper for checking for squashes before starting a translation.
         void startWalkWrapper();
 
@@ -191,6 +214,15 @@ namespace X86ISA
         void recvReqRetry();
         bool sendTiming(WalkerState * sendingState, PacketPtr pkt);
 
+        struct WalkerStats : public statistics::Group
+        {
+            WalkerStats(statistics::Group *parent);
+
+            statistics::Scalar walkCacheHits;
+            statistics::Scalar walkCacheMisses;
+            statistics::Scalar coalescedWalks;
+        } stats;
+
       public:
 
         void setTLB(TLB * _tlb)
@@ -198,6 +230,11 @@ namespace X86ISA
             tlb = _tlb;
         }
 
+        void flushWalkCache()
+        {
+            walkCache.flush();
+        }
+
         using Params = X86PagetableWalkerParams;
 
         Walker(const Params &params) :
@@ -205,7 +242,9 @@ namespace X86ISA
             funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
             requestorId(sys->getRequestorId(this)),
             numSquashable(params.num_squash_per_cycle),
-            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
+            walkCache(params.walk_cache_size),
+            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name()),
+            stats(this)
         {
         }
     };
@@ -152,6 +152,7 @@ TLB::flushAll()
             freeList.push_back(&tlb[i]);
         }
     }
+    walker->flushWalkCache();
 }
 
 void
@@ -171,6 +172,7 @@ TLB::flushNonGlobal()
             freeList.push_back(&tlb[i]);
         }
     }
+    walker->flushWalkCache();
 }
 
 void
@@ -182,6 +184,7 @@ TLB::demapPage(Addr va, uint64_t asn)
         entry->trieHandle = NULL;
         freeList.push_back(entry);
     }
+    walker->flushWalkCache();
 }
 
 namespace
@@ -443,8 +446,7 @@ TLB::translate(const RequestPtr &req,
                     assert(entry);
                 } else {
                     Process *p = tc->getProcessPtr();
-                    const EmulationPageTable::Entry *pte =
-                        p->pTable->lookup(vaddr);
+                    auto pte = p->pTable->lookup(vaddr);
                     if (!pte) {
                         return std::make_shared<PageFault>(vaddr, true, mode,
                                                            true, false);
@@ -527,7 +529,7 @@ TLB::translateFunctional(const RequestPtr &req, ThreadContext *tc,
         paddr = insertBits(addr, logBytes - 1, 0, vaddr);
     } else {
         Process *process = tc->getProcessPtr();
-        const auto *pte = process->pTable->lookup(vaddr);
+        auto pte = process->pTable->lookup(vaddr);
 
         if (!pte && mode != BaseMMU::Execute) {
             // Check if we just need to grow the stack.
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_GTEST_HOST_FP_OPERANDS_HH__
+#define __BASE_GTEST_HOST_FP_OPERANDS_HH__
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * Operands for testing floating point arithmetic done on the host FPU
+ * (see base/host_fp.hh), as the bit patterns of single or double
+ * precision values.
+ */
+namespace host_fp_operands
+{
+
+/**
+ * Values which exercise the cases the host FPU can't handle on its own,
+ * in addition to the random operands.
+ */
+template <typename T>
+const std::vector<T> &special();
+
+template <>
+inline const std::vector<uint32_t> &
+special()
+{
+    static const std::vector<uint32_t> values = {
+        0x00000000, 0x80000000, // Zeros
+        0x00000001, 0x807fffff, // Subnormals
+        0x00800000, 0x80800001, // Smallest normals
+        0x3f800000, 0xbf800000, 0x40000000, 0x3fffffff,
+        0x7f7fffff, 0xff7fffff, // Largest normals
+        0x7f800000, 0xff800000, // Infinities
+        0x7fc00000, 0x7f800001, // Quiet and signaling NaNs
+    };
+    return values;
+}
+
+template <>
+inline const std::vector<uint64_t> &
+special()
+{
+    static const std::vector<uint64_t> values = {
+        0x0000000000000000, 0x8000000000000000,
+        0x0000000000000001, 0x800fffffffffffff,
+        0x0010000000000000, 0x8010000000000001,
+        0x3ff0000000000000, 0xbff0000000000000, 0x4000000000000000,
+        0x3fffffffffffffff,
+        0x7fefffffffffffff, 0xffefffffffffffff,
+        0x7ff0000000000000, 0xfff0000000000000,
+        0x7ff8000000000000, 0x7ff0000000000001,
+    };
+    return values;
+}
+
+/**
+ * A random value with its exponent clustered around the smallest, the
+ * unbiased and the largest exponent, so overflow, underflow and subnormal
+ * results are all likely. A quarter of the values have the low half of
+ * their fraction cleared so that some results are exact.
+ */
+template <typename T, int ExpBits, int FracBits>
+T
+randomFloat(std::mt19937_64 &rng)
+{
+    const T bias = (T(1) << (ExpBits - 1)) - 1;
+    const T max_exp = (T(1) << ExpBits) - 1;
+    const T centers[] = {1, bias, max_exp - 1};
+    T sign = rng() & 1;
+    T exp = (centers[rng() % 3] + rng() % 48 - 24) & max_exp;
+    T frac = rng() & ((T(1) << FracBits) - 1);
+    if (rng() % 4 == 0)
+        frac &= ~((T(1) << (FracBits / 2)) - 1);
+    return sign << (ExpBits + FracBits) | exp << FracBits | frac;
+}
+
+template <typename T>
+T random(std::mt19937_64 &rng);
+
+template <>
+inline uint32_t
+random(std::mt19937_64 &rng)
+{
+    return randomFloat<uint32_t, 8, 23>(rng);
+}
+
+template <>
+inline uint64_t
+random(std::mt19937_64 &rng)
+{
+    return randomFloat<uint64_t, 11, 52>(rng);
+}
+
+/**
+ * Call check(a, b) for every pair of special values, and for count pairs
+ * of random values. Each random pair is followed by a pair of nearly
+ * equal values of opposite signs, which cancel in an addition.
+ */
+template <typename T, typename Check>
+void
+forPairs(int count, Check check)
+{
+    const T sign = T(1) << (sizeof(T) * 8 - 1);
+
+    for (T a: special<T>())
+        for (T b: special<T>())
+            check(a, b);
+
+    std::mt19937_64 rng(0x5eed);
+    for (int i = 0; i < count; i++) {
+        T a = random<T>(rng), b = random<T>(rng);
+        check(a, b);
+        check(a, T((a ^ sign) + rng() % 3 - 1));
+    }
+}
+
+} // namespace host_fp_operands
+} // namespace gem5
+
+#endif // __BASE_GTEST_HOST_FP_OPERANDS_HH__
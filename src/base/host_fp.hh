@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_HOST_FP_HH__
+#define __BASE_HOST_FP_HH__
+
+#include <cmath>
+#include <limits>
+
+#include "base/fenv.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/*
+ * IEEE 754 arithmetic on the host FPU for the floating point emulation of
+ * the ISAs, which is a lot faster than a software implementation.
+ *
+ * Changing the host rounding mode and reading the host exception flags is
+ * about as slow as emulating the operation, so the host FPU is always used
+ * in its default round to nearest mode. The exact error of the rounded
+ * result is computed with an error free transformation (TwoSum or an FMA),
+ * which tells whether the result is inexact and how to round it in the
+ * other rounding modes.
+ *
+ * The functions only handle the common case: finite operands and a normal
+ * result, which raise no exception except inexact. They return false for
+ * everything else, i.e. NaNs, infinities, overflow, underflow, invalid
+ * operations, division by zero and operands too small for the error to be
+ * exact, which then has to be handled by the ISA's emulation code.
+ */
+namespace host_fp
+{
+
+/**
+ * Whether a value is large enough for the error of a product, quotient or
+ * square root involving it to be exactly representable.
+ */
+template <typename Host>
+static inline bool
+errorIsExact(Host x)
+{
+    constexpr Host eps = std::numeric_limits<Host>::epsilon();
+    return std::fabs(x) >= std::numeric_limits<Host>::min() / (eps * eps);
+}
+
+/**
+ * Round a result to the requested rounding mode.
+ *
+ * @param value The result rounded to nearest, even.
+ * @param error The sign of the exact result minus value, or zero if value
+ *     is exact.
+ * @param rm The rounding mode.
+ * @param inexact Set to whether the rounded result is inexact.
+ * @return Whether value is the correctly rounded result.
+ */
+template <typename Host>
+static inline bool
+round(Host &value, Host error, RoundingMode rm, bool &inexact)
+{
+    if (!std::isfinite(value))
+        return false;
+
+    // The correctly rounded result is either value or its neighbor on the
+    // side of the exact result. value isn't zero, so its neighbors are one
+    // away in the integer representation.
+    switch (rm) {
+      case RoundingMode::ToNearest:
+        break;
+      case RoundingMode::TowardZero:
+        if (error != 0 && std::signbit(error) != std::signbit(value))
+            value = bitsToFloat(floatToBits(value) - 1);
+        break;
+      case RoundingMode::Downward:
+        if (error < 0)
+            value = bitsToFloat(floatToBits(value) + (value < 0 ? 1 : -1));
+        break;
+      case RoundingMode::Upward:
+        if (error > 0)
+            value = bitsToFloat(floatToBits(value) + (value > 0 ? 1 : -1));
+        break;
+    }
+
+    // Overflow and underflow aren't handled.
+    if (!std::isfinite(value) ||
+            std::fabs(value) <= std::numeric_limits<Host>::min()) {
+        return false;
+    }
+
+    inexact = error != 0;
+    return true;
+}
+
+template <typename Host>
+static inline bool
+add(Host a, Host b, RoundingMode rm, Host &sum, bool &inexact)
+{
+    if (!std::isfinite(a) || !std::isfinite(b))
+        return false;
+    sum = a + b;
+    if (sum == 0) {
+        // Exact cancellation is the only way to get zero, and its sign
+        // depends on the rounding mode.
+        inexact = false;
+        return rm != RoundingMode::Downward;
+    }
+    // TwoSum.
+    Host b_virt = sum - a;
+    Host a_virt = sum - b_virt;
+    Host error = (a - a_virt) + (b - b_virt);
+    return round(sum, error, rm, inexact);
+}
+
+template <typename Host>
+static inline bool
+mul(Host a, Host b, RoundingMode rm, Host &product, bool &inexact)
+{
+    if (!std::isfinite(a) || !std::isfinite(b))
+        return false;
+    product = a * b;
+    if (a == 0 || b == 0) {
+        inexact = false;
+        return true;
+    }
+    if (!errorIsExact(product))
+        return false;
+    return round(product, std::fma(a, b, -product), rm, inexact);
+}
+
+template <typename Host>
+static inline bool
+div(Host a, Host b, RoundingMode rm, Host &quotient, bool &inexact)
+{
+    if (!std::isfinite(a) || !std::isfinite(b) || b == 0)
+        return false;
+    quotient = a / b;
+    if (a == 0) {
+        inexact = false;
+        return true;
+    }
+    if (!errorIsExact(a) || !errorIsExact(b) || !errorIsExact(quotient))
+        return false;
+    // The exact quotient minus the result is the remainder divided by b.
+    Host remainder = std::fma(-quotient, b, a);
+    return round(quotient, b > 0 ? remainder : -remainder, rm, inexact);
+}
+
+template <typename Host>
+static inline bool
+sqrt(Host a, RoundingMode rm, Host &root, bool &inexact)
+{
+    if (!std::isfinite(a) || std::signbit(a))
+        return false;
+    root = std::sqrt(a);
+    if (a == 0) {
+        inexact = false;
+        return true;
+    }
+    if (!errorIsExact(a))
+        return false;
+    return round(root, std::fma(-root, root, a), rm, inexact);
+}
+
+} // namespace host_fp
+} // namespace gem5
+
+#endif // __BASE_HOST_FP_HH__
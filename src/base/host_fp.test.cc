@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cfenv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "base/gtest/host_fp_operands.hh"
+#include "base/host_fp.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+const RoundingMode roundingModes[] = {
+    RoundingMode::ToNearest, RoundingMode::TowardZero,
+    RoundingMode::Downward, RoundingMode::Upward,
+};
+
+int
+hostRounding(RoundingMode rm)
+{
+    switch (rm) {
+      case RoundingMode::Downward:
+        return FE_DOWNWARD;
+      case RoundingMode::TowardZero:
+        return FE_TOWARDZERO;
+      case RoundingMode::Upward:
+        return FE_UPWARD;
+      default:
+        return FE_TONEAREST;
+    }
+}
+
+/**
+ * The correctly rounded result of an operation and the exceptions it
+ * raises, computed by the host FPU in the requested rounding mode.
+ */
+template <typename Host, typename Op>
+Host
+reference(Host a, Host b, RoundingMode rm, Op op, int &excepts)
+{
+    // The volatile operands and result keep the compiler from moving the
+    // operation out from between the rounding mode and flag accesses.
+    volatile Host x = a, y = b;
+    std::fesetround(hostRounding(rm));
+    std::feclearexcept(FE_ALL_EXCEPT);
+    volatile Host result = op(x, y);
+    excepts = std::fetestexcept(FE_ALL_EXCEPT);
+    std::fesetround(FE_TONEAREST);
+    return result;
+}
+
+/**
+ * Check that whenever an operation computed in round to nearest with an
+ * error free transformation is accepted, it gives the correctly rounded
+ * result and inexact flag of every rounding mode, and that it would have
+ * raised no other exception.
+ */
+template <typename Host, typename Fast, typename Op>
+void
+check(Host a, Host b, Fast fast, Op op)
+{
+    for (RoundingMode rm: roundingModes) {
+        Host result;
+        bool inexact;
+        if (!fast(a, b, rm, result, inexact))
+            continue;
+
+        int excepts;
+        Host expected = reference(a, b, rm, op, excepts);
+        ASSERT_EQ(floatToBits(expected), floatToBits(result)) << std::hex <<
+            "a: " << floatToBits(a) << " b: " << floatToBits(b) <<
+            " rm: " << (int)rm;
+        ASSERT_EQ((bool)(excepts & FE_INEXACT), inexact) << std::hex <<
+            "a: " << floatToBits(a) << " b: " << floatToBits(b) <<
+            " rm: " << (int)rm;
+        ASSERT_EQ(excepts & ~FE_INEXACT, 0) << std::hex <<
+            "a: " << floatToBits(a) << " b: " << floatToBits(b) <<
+            " rm: " << (int)rm;
+    }
+}
+
+template <typename Host>
+void
+checkAll(Host a, Host b)
+{
+    check(a, b, host_fp::add<Host>,
+            [](Host x, Host y) -> Host { return x + y; });
+    check(a, b, host_fp::mul<Host>,
+            [](Host x, Host y) -> Host { return x * y; });
+    check(a, b, host_fp::div<Host>,
+            [](Host x, Host y) -> Host { return x / y; });
+    check(a, b,
+            [](Host x, Host, RoundingMode rm, Host &root, bool &inexact) {
+                return host_fp::sqrt(x, rm, root, inexact);
+            },
+            [](Host x, Host) -> Host { return std::sqrt(x); });
+}
+
+/** Whether all operations take a pair of operands in every mode. */
+template <typename Host>
+bool
+allTaken(Host a, Host b)
+{
+    for (RoundingMode rm: roundingModes) {
+        Host result;
+        bool inexact;
+        if (!host_fp::add(a, b, rm, result, inexact) ||
+                !host_fp::mul(a, b, rm, result, inexact) ||
+                !host_fp::div(a, b, rm, result, inexact) ||
+                !host_fp::sqrt(std::fabs(a), rm, result, inexact)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+TEST(HostFpTest, F32)
+{
+    host_fp_operands::forPairs<uint32_t>(100000, [](uint32_t a, uint32_t b) {
+        checkAll(bitsToFloat(a), bitsToFloat(b));
+    });
+}
+
+TEST(HostFpTest, F64)
+{
+    host_fp_operands::forPairs<uint64_t>(100000, [](uint64_t a, uint64_t b) {
+        checkAll(bitsToFloat(a), bitsToFloat(b));
+    });
+}
+
+TEST(HostFpTest, TakesCommonCases)
+{
+    // Operands of moderate magnitude, which is where the host FPU has to
+    // be used for it to be of any help.
+    EXPECT_TRUE(allTaken(1.0f, 3.0f));
+    EXPECT_TRUE(allTaken(-1.1f, 3.3e-5f));
+    EXPECT_TRUE(allTaken(1e30f, -7.0f));
+    EXPECT_TRUE(allTaken(1.0, 3.0));
+    EXPECT_TRUE(allTaken(-1.1, 3.3e-5));
+    EXPECT_TRUE(allTaken(1e300, -7.0));
+}
+
+TEST(HostFpTest, LeavesSpecialCases)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double max = std::numeric_limits<double>::max();
+    const double min = std::numeric_limits<double>::min();
+    const double denorm = std::numeric_limits<double>::denorm_min();
+    double result;
+    bool inexact;
+
+    // NaN and infinite operands.
+    EXPECT_FALSE(host_fp::add(nan, 1.0, RoundingMode::ToNearest,
+                result, inexact));
+    EXPECT_FALSE(host_fp::mul(inf, 1.0, RoundingMode::ToNearest,
+                result, inexact));
+    // Overflow, and the overflow rounding would produce in other modes.
+    EXPECT_FALSE(host_fp::mul(max, 2.0, RoundingMode::ToNearest,
+                result, inexact));
+    EXPECT_FALSE(host_fp::add(max, max * 0x1p-53, RoundingMode::Upward,
+                result, inexact));
+    // Underflow, and operands too small for the error to be exact.
+    EXPECT_FALSE(host_fp::mul(min, 0.5, RoundingMode::ToNearest,
+                result, inexact));
+    EXPECT_FALSE(host_fp::div(denorm, 3.0, RoundingMode::ToNearest,
+                result, inexact));
+    EXPECT_FALSE(host_fp::sqrt(denorm, RoundingMode::ToNearest,
+                result, inexact));
+    // Invalid operations and division by zero.
+    EXPECT_FALSE(host_fp::sqrt(-1.0, RoundingMode::ToNearest,
+                result, inexact));
+    EXPECT_FALSE(host_fp::div(1.0, 0.0, RoundingMode::ToNearest,
+                result, inexact));
+    // An exact cancellation gives -0 rounding downward, which isn't
+    // the sign the host FPU gives in round to nearest.
+    EXPECT_FALSE(host_fp::add(1.0, -1.0, RoundingMode::Downward,
+                result, inexact));
+    EXPECT_TRUE(host_fp::add(1.0, -1.0, RoundingMode::ToNearest,
+                result, inexact));
+    EXPECT_FALSE(std::signbit(result));
+    EXPECT_FALSE(inexact);
+}
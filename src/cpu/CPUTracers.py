@@ -35,6 +35,26 @@ class ExeTracer(InstTracer):
     cxx_header = "cpu/exetrace.hh"
 
 
+class BinaryTracer(InstTracer):
+    """Writes a compact binary instruction trace from a background thread.
+    Use util/decode_binary_inst_trace.py to turn it into the ExeTracer text
+    format."""
+
+    type = "BinaryTracer"
+    cxx_class = "gem5::trace::BinaryTracer"
+    cxx_header = "cpu/binary_trace.hh"
+
+    trace_file = Param.String(
+        "", "Trace (output) file, defaults to <tracer name>.bin.gz"
+    )
+    buffer_size = Param.MemorySize(
+        "1MiB", "Size of the buffers handed over to the writer thread"
+    )
+    max_pending_buffers = Param.Unsigned(
+        4, "Number of full buffers before the simulation waits for the writer"
+    )
+
+
 class IntelTrace(InstTracer):
     type = "IntelTrace"
     cxx_class = "gem5::trace::IntelTrace"
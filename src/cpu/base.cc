@@ -753,6 +753,12 @@ BaseCPU::getCurrentInstCount(ThreadID tid)
     return threadContexts[tid]->getCurrentInstCount();
 }
 
+uint64_t
+BaseCPU::getCurrentCycleCount() const
+{
+    return baseStats.numCycles.value();
+}
+
 AddressMonitor::AddressMonitor()
 {
     armed = false;
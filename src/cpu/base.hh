@@ -485,6 +485,14 @@ class BaseCPU : public ClockedObject
      */
     uint64_t getCurrentInstCount(ThreadID tid);
 
+    /**
+     * Get the number of cycles simulated by this CPU. Used by Python
+     * to measure CPI over an instruction window, e.g., when sampling.
+     *
+     * @return Number of cycles simulated
+     */
+    uint64_t getCurrentCycleCount() const;
+
   public:
     /**
      * @{
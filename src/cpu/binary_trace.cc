@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/binary_trace.hh"
+
+#include <sstream>
+
+#include "base/loader/symtab.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "enums/OpClass.hh"
+#include "sim/byteswap.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+void
+BinaryTracerRecord::dump()
+{
+    const Addr cur_pc = pc->instAddr();
+
+    tracer.setCPU(thread->getCpuPtr());
+
+    // Describe the static instructions before the entry referring to them.
+    const uint32_t inst_id = tracer.instId(staticInst, cur_pc);
+    const uint32_t macro_id =
+        macroStaticInst ? tracer.instId(macroStaticInst, cur_pc) : 0;
+
+    BinaryTracer::InstEntry entry;
+    entry.when = htole<uint64_t>(when);
+    entry.pc = htole<uint64_t>(cur_pc);
+    entry.addr = htole<uint64_t>(mem_valid ? addr : 0);
+    entry.data = htole<uint64_t>(
+            (dataStatus != DataInvalid && dataStatus != DataReg) ?
+            data.asInt : 0);
+    entry.fetchSeq = htole<uint64_t>(fetch_seq_valid ? fetch_seq : 0);
+    entry.cpSeq = htole<uint64_t>(cp_seq_valid ? cp_seq : 0);
+    entry.inst = htole<uint32_t>(inst_id);
+    entry.macroInst = htole<uint32_t>(macro_id);
+    entry.asid = htole<uint32_t>(thread->getIsaPtr()->getExecutingAsid());
+    entry.microPC = htole<uint16_t>(pc->microPC());
+    entry.threadId = htole<uint16_t>(thread->threadId());
+    entry.dataStatus = dataStatus;
+
+    uint8_t flags = 0;
+    if (mem_valid)
+        flags |= BinaryTracer::InstEntry::MemValid;
+    if (fetch_seq_valid)
+        flags |= BinaryTracer::InstEntry::FetchSeqValid;
+    if (cp_seq_valid)
+        flags |= BinaryTracer::InstEntry::CPSeqValid;
+    if (!predicate)
+        flags |= BinaryTracer::InstEntry::PredicateFalse;
+    if (thread->getIsaPtr()->inUserMode())
+        flags |= BinaryTracer::InstEntry::UserMode;
+    if (faulting)
+        flags |= BinaryTracer::InstEntry::Faulting;
+    entry.flags = flags;
+
+    const char tag = 'I';
+    tracer.append(&tag, sizeof(tag));
+    tracer.append(&entry, sizeof(entry));
+
+    if (dataStatus == DataReg) {
+        const char result_tag = 'R';
+        tracer.append(&result_tag, sizeof(result_tag));
+        tracer.appendString(data.asReg.asString());
+    }
+}
+
+BinaryTracer::BinaryTracer(const Params &p)
+    : InstTracer(p),
+      traceStream(nullptr),
+      bufferSize(p.buffer_size),
+      maxPendingBuffers(p.max_pending_buffers),
+      lastCPU(nullptr),
+      closing(false)
+{
+    fatal_if(!bufferSize, "%s: The trace buffer size must not be zero.",
+             name());
+    fatal_if(!maxPendingBuffers,
+             "%s: At least one pending trace buffer is needed.", name());
+
+    const std::string file_name = p.trace_file.empty() ?
+        name() + ".bin.gz" : p.trace_file;
+    traceStream = simout.create(file_name, true);
+    fatal_if(!traceStream, "%s: Unable to open trace file %s.", name(),
+             file_name);
+
+    buffer.reserve(bufferSize);
+    writer = std::thread(&BinaryTracer::writeBuffers, this);
+
+    // SimObjects are not destroyed when the simulator exits, write the
+    // remaining records from an exit callback.
+    registerExitCallback([this]() { close(); });
+}
+
+BinaryTracer::~BinaryTracer()
+{
+    close();
+}
+
+uint32_t
+BinaryTracer::instId(const StaticInstPtr &inst, Addr pc)
+{
+    auto it = instIds.find(inst.get());
+    if (it != instIds.end())
+        return it->second.id;
+
+    const uint32_t id = instIds.size() + 1;
+    instIds.emplace(inst.get(), InstInfo{id, inst});
+
+    uint8_t kind = 0;
+    if (inst->isMicroop())
+        kind |= 0x1;
+    if (inst->isFirstMicroop())
+        kind |= 0x2;
+    if (inst->isLastMicroop())
+        kind |= 0x4;
+
+    std::stringstream flags;
+    inst->printFlags(flags, "|");
+
+    const char tag = 'S';
+    const uint32_t le_id = htole(id);
+    append(&tag, sizeof(tag));
+    append(&le_id, sizeof(le_id));
+    append(&kind, sizeof(kind));
+    appendString(enums::OpClassStrings[inst->opClass()]);
+    appendString(inst->disassemble(pc, &loader::debugSymbolTable));
+    appendString(flags.str());
+
+    return id;
+}
+
+void
+BinaryTracer::nameCPU(const BaseCPU *cpu)
+{
+    const char tag = 'N';
+    append(&tag, sizeof(tag));
+    appendString(cpu->name());
+    lastCPU = cpu;
+}
+
+void
+BinaryTracer::append(const void *data, size_t size)
+{
+    const char *bytes = static_cast<const char *>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+    if (buffer.size() >= bufferSize)
+        flush();
+}
+
+void
+BinaryTracer::appendString(const std::string &str)
+{
+    const uint16_t size = std::min<size_t>(str.size(), UINT16_MAX);
+    const uint16_t le_size = htole(size);
+    append(&le_size, sizeof(le_size));
+    append(str.data(), size);
+}
+
+void
+BinaryTracer::flush()
+{
+    if (buffer.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    // Stall the simulation if the writer thread cannot keep up rather
+    // than buffering an unbounded amount of records.
+    cv.wait(lock, [this]() {
+        return pendingBuffers.size() < maxPendingBuffers;
+    });
+    pendingBuffers.emplace_back(std::move(buffer));
+    lock.unlock();
+    cv.notify_all();
+
+    buffer = std::vector<char>();
+    buffer.reserve(bufferSize);
+}
+
+void
+BinaryTracer::close()
+{
+    if (!writer.joinable())
+        return;
+
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    cv.notify_all();
+    writer.join();
+
+    simout.close(traceStream);
+    traceStream = nullptr;
+}
+
+void
+BinaryTracer::writeBuffers()
+{
+    std::ostream &os = *traceStream->stream();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait(lock, [this]() {
+            return closing || !pendingBuffers.empty();
+        });
+        if (pendingBuffers.empty())
+            break;
+
+        std::vector<char> data = std::move(pendingBuffers.front());
+        pendingBuffers.pop_front();
+        lock.unlock();
+        cv.notify_all();
+
+        os.write(data.data(), data.size());
+
+        lock.lock();
+    }
+    os.flush();
+}
+
+} // namespace trace
+} // namespace gem5
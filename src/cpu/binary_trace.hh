@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_BINARY_TRACE_HH__
+#define __CPU_BINARY_TRACE_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base/output.hh"
+#include "cpu/static_inst.hh"
+#include "params/BinaryTracer.hh"
+#include "sim/insttracer.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+class ThreadContext;
+
+namespace trace {
+
+class BinaryTracer;
+
+/**
+ * Instruction record of the BinaryTracer. Instead of formatting the
+ * instruction like the ExeTracer does, it packs it into a fixed size
+ * binary record. The text can be recreated offline with
+ * util/decode_binary_inst_trace.py.
+ */
+class BinaryTracerRecord : public InstRecord
+{
+  public:
+    BinaryTracerRecord(BinaryTracer &_tracer, Tick _when,
+                       ThreadContext *_thread,
+                       const StaticInstPtr _staticInst,
+                       const PCStateBase &_pc,
+                       const StaticInstPtr _macroStaticInst = NULL)
+        : InstRecord(_when, _thread, _staticInst, _pc, _macroStaticInst),
+          tracer(_tracer)
+    {
+    }
+
+    void dump() override;
+
+  private:
+    BinaryTracer &tracer;
+};
+
+/**
+ * Instruction tracer writing a compact binary trace. Records are
+ * collected in a buffer on the simulation thread and handed over to a
+ * background thread, which writes (and, for .gz files, compresses)
+ * them. Each CPU has its own tracer and therefore its own trace file.
+ *
+ * The trace is a sequence of entries, each starting with a one byte tag:
+ * - 'N': the name of the CPU the following instructions belong to.
+ * - 'S': a static instruction seen for the first time: its id, kind
+ *   flags and the op class, disassembly and flag strings.
+ * - 'I': a committed instruction, see InstEntry.
+ * - 'R': the formatted result of the preceding 'I' entry if it does not
+ *   fit in 64 bits.
+ * Strings are stored as a 16 bit length followed by the characters. All
+ * integers are little endian.
+ */
+class BinaryTracer : public InstTracer
+{
+  public:
+    typedef BinaryTracerParams Params;
+    BinaryTracer(const Params &params);
+    ~BinaryTracer();
+
+    InstRecord *
+    getInstRecord(Tick when, ThreadContext *tc,
+            const StaticInstPtr staticInst, const PCStateBase &pc,
+            const StaticInstPtr macroStaticInst=nullptr) override
+    {
+        return new BinaryTracerRecord(*this, when, tc,
+                staticInst, pc, macroStaticInst);
+    }
+
+    /** Fixed size record of a committed instruction. */
+    struct GEM5_PACKED InstEntry
+    {
+        enum Flags : uint8_t
+        {
+            MemValid = 0x01,
+            FetchSeqValid = 0x02,
+            CPSeqValid = 0x04,
+            PredicateFalse = 0x08,
+            UserMode = 0x10,
+            Faulting = 0x20
+        };
+
+        uint64_t when;
+        uint64_t pc;
+        uint64_t addr;
+        uint64_t data;
+        uint64_t fetchSeq;
+        uint64_t cpSeq;
+        /** Id of the static instruction, see 'S' entries. */
+        uint32_t inst;
+        /** Id of the macroop, 0 if the instruction is not a microop. */
+        uint32_t macroInst;
+        uint32_t asid;
+        uint16_t microPC;
+        uint16_t threadId;
+        /** InstRecord::DataStatus of the data field. */
+        uint8_t dataStatus;
+        uint8_t flags;
+    };
+
+    /**
+     * Get the id of a static instruction, describing it in the trace
+     * first if it was not seen before.
+     */
+    uint32_t instId(const StaticInstPtr &inst, Addr pc);
+
+    /** Name the CPU of the next records in the trace if it changed. */
+    void
+    setCPU(const BaseCPU *cpu)
+    {
+        if (cpu != lastCPU)
+            nameCPU(cpu);
+    }
+
+    /** Append an entry to the current buffer. */
+    void append(const void *data, size_t size);
+
+    /** Append a string entry field to the current buffer. */
+    void appendString(const std::string &str);
+
+  private:
+    void nameCPU(const BaseCPU *cpu);
+
+    /** Hand the current buffer over to the writer thread. */
+    void flush();
+
+    /** Write any remaining records and stop the writer thread. */
+    void close();
+
+    /** Main loop of the writer thread. */
+    void writeBuffers();
+
+    /** Output stream, only used by the writer thread once started. */
+    OutputStream *traceStream;
+
+    /** Size at which a buffer is handed over to the writer thread. */
+    const size_t bufferSize;
+
+    /** Buffers the writer thread may lag behind before tracing stalls. */
+    const size_t maxPendingBuffers;
+
+    struct InstInfo
+    {
+        uint32_t id;
+        /** Keeps the instruction alive so its address is not reused. */
+        StaticInstPtr inst;
+    };
+    std::unordered_map<const StaticInst *, InstInfo> instIds;
+
+    /** CPU named by the last 'N' entry. */
+    const BaseCPU *lastCPU;
+
+    std::vector<char> buffer;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    /** Buffers waiting to be written, protected by mutex. */
+    std::deque<std::vector<char>> pendingBuffers;
+    /** Tells the writer thread to exit, protected by mutex. */
+    bool closing;
+    std::thread writer;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_BINARY_TRACE_HH__
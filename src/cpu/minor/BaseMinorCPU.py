@@ -406,6 +406,12 @@ class BaseMinorCPU(BaseCPU):
         True, "Enable cycle skipping when the processor is idle\n"
     )
 
+    enableCycleSkipping = Param.Bool(
+        False,
+        "Skip cycles in which only the functional unit pipelines advance"
+        " (requires enableIdling)",
+    )
+
     branchPred = Param.BranchPredictor(
         TournamentBP(numThreads=Parent.numThreads), "Branch Predictor"
     )
@@ -305,16 +305,20 @@ class SelfStallingPipeline : public MinorBuffer<ElemType, ReportTraits>
     /** The number of slots with non-bubbles in them */
     unsigned int occupancy;
 
+    /** The number of slots between the input and output ends */
+    const unsigned int depth;
+
   public:
     SelfStallingPipeline(const std::string &name,
         const std::string &data_name,
-        unsigned depth) :
+        unsigned depth_) :
         MinorBuffer<ElemType, ReportTraits>
-            (name, data_name, depth, 0, -1, -depth),
+            (name, data_name, depth_, 0, -1, -depth_),
         pushWire(this->getWire(0)),
-        popWire(this->getWire(-depth)),
+        popWire(this->getWire(-depth_)),
         stalled(false),
-        occupancy(0)
+        occupancy(0),
+        depth(depth_)
     {
         assert(depth > 0);
 
@@ -348,6 +352,19 @@ class SelfStallingPipeline : public MinorBuffer<ElemType, ReportTraits>
     /** There's data (not a bubble) at the end of the pipe */
     bool isPopable() { return !BubbleTraits::isBubble(front()); }
 
+    /** How many calls to advance are needed before the non-bubble
+     *  nearest the end of the pipe becomes popable.  Returns 0 if the pipe
+     *  is empty or already popable */
+    unsigned int
+    advancesUntilPopable()
+    {
+        for (unsigned int i = 1; i <= depth; i++) {
+            if (!BubbleTraits::isBubble((*this)[-int(depth - i)]))
+                return i;
+        }
+        return 0;
+    }
+
     /** Try to advance the pipeline.  If we're stalled, don't advance.  If
      *  we're not stalled, advance then check to see if we become stalled
      *  (a non-bubble at the end of the pipe) */
@@ -255,9 +255,12 @@ MinorCPU::activateContext(ThreadID thread_id)
 
     /* Do some cycle accounting.  lastStopped is reset to stop the
      *  wakeup call on the pipeline from adding the quiesce period
-     *  to BaseCPU::numCycles */
-    stats.quiesceCycles += pipeline->cyclesSinceLastStopped();
-    pipeline->resetLastStopped();
+     *  to BaseCPU::numCycles.  Cycles skipped while other threads are
+     *  busy are not a quiesce period */
+    if (!pipeline->isSkipping()) {
+        stats.quiesceCycles += pipeline->cyclesSinceLastStopped();
+        pipeline->resetLastStopped();
+    }
 
     /* Wake up the thread, wakeup the pipeline tick */
     threads[thread_id]->activate();
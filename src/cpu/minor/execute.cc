@@ -37,7 +37,9 @@
 
 #include "cpu/minor/execute.hh"
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 
 #include "cpu/minor/cpu.hh"
 #include "cpu/minor/exec_context.hh"
@@ -92,7 +94,10 @@ Execute::Execute(const std::string &name_,
             ExecuteThreadInfo(params.executeCommitLimit)),
     interruptPriority(0),
     issuePriority(0),
-    commitPriority(0)
+    commitPriority(0),
+    skippableCycles(0),
+    fuCatchUpPending(false),
+    skipStartCycle(0)
 {
     if (commitLimit < 1) {
         fatal("%s: executeCommitLimit must be >= 1 (%d)\n", name_,
@@ -1420,6 +1425,21 @@ Execute::isInbetweenInsts(ThreadID thread_id) const
 void
 Execute::evaluate()
 {
+    if (fuCatchUpPending) {
+        /* The skipped cycles would only have advanced the FU pipelines, so
+         *  do that now.  An event may have restarted the pipeline before
+         *  all the skippable cycles passed */
+        Cycles skipped = getSkippedCycles();
+        assert(skipped <= skippableCycles);
+
+        DPRINTF(Activity, "Advancing FUs over %d skipped cycles\n", skipped);
+        for (FUPipeline *fu : funcUnits) {
+            for (Cycles i(0); i < skipped && !fu->stalled; ++i)
+                fu->advance();
+        }
+        fuCatchUpPending = false;
+    }
+
     if (!inp.outputWire->isBubble())
         inputBuffer[inp.outputWire->threadId].setTail(*inp.outputWire);
 
@@ -1505,11 +1525,13 @@ Execute::evaluate()
      * clock cycle */
     std::vector<MinorDynInstPtr> next_issuable_insts;
     bool can_issue_next = false;
+    bool have_input = false;
 
     for (ThreadID tid = 0; tid < cpu.numThreads; tid++) {
         /* Find the next issuable instruction for each thread and see if it can
            be issued */
         if (getInput(tid)) {
+            have_input = true;
             unsigned int input_index = executeInfo[tid].inputIndex;
             MinorDynInstPtr inst = getInput(tid)->insts[input_index];
             if (inst->isFault()) {
@@ -1591,6 +1613,30 @@ Execute::evaluate()
             " advanceable FUs\n");
     }
 
+    /* If the FU pipelines are the only reason to tick, the following
+     *  cycles only advance them until an instruction reaches the end of
+     *  an FU.  Input which might become issuable (and whose issue timing
+     *  depends on the FU forwarding latencies) or a thread which is
+     *  draining prevents skipping */
+    skippableCycles = Cycles(0);
+    if (num_issued == 0 && !becoming_stalled && !can_issue_next &&
+        !head_inst_might_commit && !lsq.needsToTick() && !interrupted &&
+        !have_input && branch.isBubble())
+    {
+        bool draining = false;
+        for (auto const &info : executeInfo)
+            draining = draining || info.drainState != NotDraining;
+
+        if (!draining) {
+            unsigned int advances = std::numeric_limits<unsigned int>::max();
+            for (FUPipeline *fu : funcUnits) {
+                if (fu->occupancy != 0 && !fu->stalled)
+                    advances = std::min(advances, fu->advancesUntilPopable());
+            }
+            skippableCycles = Cycles(advances);
+        }
+    }
+
     /* Wake up if we need to tick again */
     if (need_to_tick)
         cpu.wakeupOnEvent(Pipeline::ExecuteStageId);
@@ -1650,6 +1696,24 @@ Execute::hasInterrupt(ThreadID thread_id)
     return false;
 }
 
+void
+Execute::skipCycles()
+{
+    assert(skippableCycles != 0);
+
+    fuCatchUpPending = true;
+    skipStartCycle = cpu.curCycle();
+}
+
+Cycles
+Execute::getSkippedCycles() const
+{
+    if (!fuCatchUpPending)
+        return Cycles(0);
+
+    return cpu.curCycle() - skipStartCycle - Cycles(1);
+}
+
 void
 Execute::minorTrace() const
 {
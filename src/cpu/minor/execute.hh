@@ -210,6 +210,19 @@ class Execute : public Named
     ThreadID issuePriority;
     ThreadID commitPriority;
 
+    /** Number of cycles after the last evaluate in which Execute would
+     *  only advance its FU pipelines.  0 if anything else may happen in
+     *  the next cycle */
+    Cycles skippableCycles;
+
+    /** Set when the Pipeline has stopped evaluating to skip cycles.  The
+     *  FU pipelines are advanced for the skipped cycles on the next
+     *  evaluate */
+    bool fuCatchUpPending;
+
+    /** The cycle of the last evaluate before cycles were skipped */
+    Cycles skipStartCycle;
+
   protected:
     friend std::ostream &operator <<(std::ostream &os, DrainState state);
 
@@ -347,6 +360,22 @@ class Execute : public Named
     /** Pass on input/buffer data to the output if you can */
     void evaluate();
 
+    /** After evaluate, the number of following cycles which need not be
+     *  evaluated as they would only advance the FU pipelines */
+    Cycles getSkippableCycles() const { return skippableCycles; }
+
+    /** Note that the Pipeline will not evaluate the following (at most
+     *  getSkippableCycles()) cycles */
+    void skipCycles();
+
+    /** Has the Pipeline stopped evaluating to skip cycles since the last
+     *  evaluate? */
+    bool isSkipping() const { return fuCatchUpPending; }
+
+    /** The number of cycles skipped since the last evaluate.  Only valid
+     *  before the next evaluate */
+    Cycles getSkippedCycles() const;
+
     void minorTrace() const;
 
     /** After thread suspension, has Execute been drained of in-flight
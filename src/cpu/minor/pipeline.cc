@@ -58,6 +58,8 @@ Pipeline::Pipeline(MinorCPU &cpu_, const BaseMinorCPUParams &params) :
     Ticked(cpu_, &(cpu_.BaseCPU::baseStats.numCycles)),
     cpu(cpu_),
     allow_idling(params.enableIdling),
+    allow_skipping(params.enableCycleSkipping),
+    skipEndEvent([this]{ start(); }, cpu_.name() + ".pipeline.skipEnd"),
     f1ToF2(cpu.name() + ".f1ToF2", "lines",
         params.fetch1ToFetch2ForwardDelay),
     f2ToF1(cpu.name() + ".f2ToF1", "prediction",
@@ -127,6 +129,14 @@ Pipeline::evaluate()
     /** We tick the CPU to update the BaseCPU cycle counters */
     cpu.tick();
 
+    /* Something else may have restarted the pipeline during a skip */
+    if (skipEndEvent.scheduled())
+        cpu.deschedule(skipEndEvent);
+
+    /* Execute was busy while the pipeline was stopped to skip cycles, so
+     *  they don't count as idle */
+    skippedCycles += execute.getSkippedCycles();
+
     /* Note that it's important to evaluate the stages in order to allow
      *  'immediate', 0-time-offset TimeBuffer activity to be visible from
      *  later stages to earlier ones in the same cycle */
@@ -154,6 +164,21 @@ Pipeline::evaluate()
         if (!activityRecorder.active() && !needToSignalDrained) {
             DPRINTF(Quiesce, "Suspending as the processor is idle\n");
             stop();
+        } else if (allow_skipping && !needToSignalDrained &&
+            execute.getSkippableCycles() != 0 &&
+            activityRecorder.getActivityCount() == 1 &&
+            activityRecorder.getStageActive(Pipeline::ExecuteStageId))
+        {
+            /* Execute is the only active stage and will only advance its
+             *  FUs for a while, skip to when it can do something else.
+             *  Events (e.g. memory responses) restart the pipeline as
+             *  they would when idle */
+            Cycles skip = execute.getSkippableCycles();
+
+            DPRINTF(Quiesce, "Skipping %d cycles while FUs advance\n", skip);
+            execute.skipCycles();
+            stop();
+            cpu.schedule(skipEndEvent, cpu.clockEdge(skip));
         }
 
         /* Deactivate all stages.  Note that the stages *could*
@@ -77,6 +77,13 @@ class Pipeline : public Ticked
     /** Allow cycles to be skipped when the pipeline is idle */
     bool allow_idling;
 
+    /** Allow cycles to be skipped when only the functional unit
+     *  pipelines in Execute are advancing */
+    bool allow_skipping;
+
+    /** Restarts the pipeline at the end of skipped cycles */
+    EventFunctionWrapper skipEndEvent;
+
     Latch<ForwardLineData> f1ToF2;
     Latch<BranchData> f2ToF1;
     Latch<ForwardInstData> f2ToD;
@@ -123,6 +130,10 @@ class Pipeline : public Ticked
     /** Test to see if the CPU is drained */
     bool isDrained();
 
+    /** Is the pipeline stopped (or just restarted) to skip cycles in
+     *  which only Execute's FUs advance? */
+    bool isSkipping() const { return execute.isSkipping(); }
+
     /** A custom evaluate allows report in the right place (between
      *  stages and pipeline advance) */
     void evaluate() override;
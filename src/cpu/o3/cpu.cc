@@ -1111,12 +1111,10 @@ CPU::squashFromTC(ThreadID tid)
     commit.generateTCEvent(tid);
 }
 
-CPU::ListIt
+void
 CPU::addInst(const DynInstPtr &inst)
 {
     instList.push_back(inst);
-
-    return --(instList.end());
 }
 
 void
@@ -1148,7 +1146,7 @@ CPU::removeFrontInst(const DynInstPtr &inst)
     removeInstsThisCycle = true;
 
     // Remove the front instruction.
-    removeList.push(inst->getInstListIt());
+    removeList.push(instList.iteratorTo(inst.get()));
 }
 
 void
@@ -1168,7 +1166,7 @@ CPU::removeInstsNotInROB(ThreadID tid)
         end_it = instList.begin();
         rob_empty = true;
     } else {
-        end_it = (rob.readTailInst(tid))->getInstListIt();
+        end_it = instList.iteratorTo(rob.readTailInst(tid).get());
         DPRINTF(O3CPU, "ROB is not empty, squashing insts not in ROB.\n");
     }
 
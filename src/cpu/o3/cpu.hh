@@ -58,6 +58,7 @@
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
+#include "cpu/o3/inst_list.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/rename.hh"
 #include "cpu/o3/rob.hh"
@@ -93,7 +94,7 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
+    typedef InstList<DynInst, CPUInstList>::iterator ListIt;
 
     friend class ThreadContext;
 
@@ -345,7 +346,7 @@ class CPU : public BaseCPU
     /** Function to add instruction onto the head of the list of the
      *  instructions.  Used when new instructions are fetched.
      */
-    ListIt addInst(const DynInstPtr &inst);
+    void addInst(const DynInstPtr &inst);
 
     /** Function to tell the CPU that an instruction has completed. */
     void instDone(ThreadID tid, const DynInstPtr &inst);
@@ -377,8 +378,10 @@ class CPU : public BaseCPU
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    /** List of all the instructions in flight, linked through the
+     *  instructions so that adding one does not allocate.
+     */
+    InstList<DynInst, CPUInstList> instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
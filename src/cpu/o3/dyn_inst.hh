@@ -45,7 +45,6 @@
 #include <algorithm>
 #include <array>
 #include <deque>
-#include <list>
 #include <string>
 
 #include "base/refcnt.hh"
@@ -57,6 +56,7 @@
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_list.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
 #include "cpu/reg_class.hh"
@@ -79,9 +79,6 @@ class DynInst : public ExecContext, public RefCounted
             InstSeqNum seq_num, CPU *cpu);
 
   public:
-    // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
-
     struct Arrays
     {
         size_t numSrcs;
@@ -316,9 +313,6 @@ class DynInst : public ExecContext, public RefCounted
     /** The thread this instruction is from. */
     ThreadID threadNumber = 0;
 
-    /** Iterator pointing to this BaseDynInst in the list of all insts. */
-    ListIt instListIt;
-
     ////////////////////// Branch Data ///////////////
     /** Predicted PC state after this instruction. */
     std::unique_ptr<PCStateBase> predPC;
@@ -933,11 +927,8 @@ class DynInst : public ExecContext, public RefCounted
     /** Assert this instruction has generated a memory request. */
     void setRequest() { instFlags[ReqMade] = true; }
 
-    /** Returns iterator to this instruction in the list of all insts. */
-    ListIt &getInstListIt() { return instListIt; }
-
-    /** Sets iterator for this instruction in the list of all insts. */
-    void setInstListIt(ListIt _instListIt) { instListIt = _instListIt; }
+    /** Links of the CPU and IQ instruction lists this instruction is on. */
+    std::array<InstListLinks<DynInst>, NumInstLists> instListLinks;
 
   public:
     /** Returns the number of consecutive store conditional failures. */
@@ -1051,7 +1051,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
 #endif
 
     // Add instruction to the CPU's list of instructions.
-    instruction->setInstListIt(cpu->addInst(instruction));
+    cpu->addInst(instruction);
 
     // Write the instruction to the first slot in the queue
     // that heads to decode.
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_LIST_HH__
+#define __CPU_O3_INST_LIST_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "base/refcnt.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * The lists an in-flight instruction can be on at the same time. Each
+ * of them uses its own set of links in the instruction.
+ */
+enum InstListId
+{
+    CPUInstList,
+    IQInstList,
+    IQExecuteList,
+    IQDeferredList,
+    /** Blocked and retried memory instructions, which are never both. */
+    IQBlockedList,
+    NumInstLists
+};
+
+/**
+ * The links an instruction needs to be on one list. The list holds its
+ * reference to an instruction in the next pointer of the instruction
+ * before it, or in its head.
+ */
+template <class Inst>
+struct InstListLinks
+{
+    RefCountingPtr<Inst> next;
+    Inst *prev = nullptr;
+    bool linked = false;
+};
+
+/**
+ * A list of in-flight instructions linked through the instructions
+ * themselves. Adding an instruction does not allocate a list node, and
+ * an instruction can be removed in constant time given a pointer to it.
+ * Iterators stay valid until the instruction they point to is removed.
+ *
+ * @tparam Inst The instruction type, which has an array of InstListLinks
+ *              named instListLinks indexed by InstListId.
+ * @tparam Id The links this list uses.
+ */
+template <class Inst, int Id>
+class InstList
+{
+  public:
+    using Ptr = RefCountingPtr<Inst>;
+
+    class iterator
+    {
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Ptr;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Ptr *;
+        using reference = const Ptr &;
+
+        iterator() = default;
+        iterator(const InstList *_list, Inst *_inst)
+            : list(_list), inst(_inst)
+        {}
+
+        reference operator*() const { return list->owner(inst); }
+        pointer operator->() const { return &list->owner(inst); }
+
+        iterator &
+        operator++()
+        {
+            inst = links(inst).next.get();
+            return *this;
+        }
+
+        iterator
+        operator++(int)
+        {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        /** Like in a std::list, decrementing begin() gives end(). */
+        iterator &
+        operator--()
+        {
+            inst = inst ? links(inst).prev : list->tail;
+            return *this;
+        }
+
+        iterator
+        operator--(int)
+        {
+            iterator it = *this;
+            --*this;
+            return it;
+        }
+
+        bool operator==(const iterator &it) const { return inst == it.inst; }
+        bool operator!=(const iterator &it) const { return inst != it.inst; }
+
+        /** The instruction pointed to, or nullptr for end(). */
+        Inst *get() const { return inst; }
+
+      private:
+        const InstList *list = nullptr;
+        Inst *inst = nullptr;
+    };
+
+    InstList() = default;
+    InstList(const InstList &) = delete;
+    InstList &operator=(const InstList &) = delete;
+
+    ~InstList() { clear(); }
+
+    bool empty() const { return !head; }
+    size_t size() const { return _size; }
+
+    iterator begin() const { return iterator(this, head.get()); }
+    iterator end() const { return iterator(this, nullptr); }
+
+    /** The iterator to an instruction on this list. */
+    iterator
+    iteratorTo(Inst *inst) const
+    {
+        assert(links(inst).linked);
+        return iterator(this, inst);
+    }
+
+    const Ptr &
+    front() const
+    {
+        assert(!empty());
+        return head;
+    }
+
+    const Ptr &
+    back() const
+    {
+        assert(!empty());
+        return owner(tail);
+    }
+
+    void
+    push_back(const Ptr &inst)
+    {
+        auto &l = links(inst.get());
+        assert(!l.linked);
+        l.linked = true;
+        l.prev = tail;
+        if (tail)
+            links(tail).next = inst;
+        else
+            head = inst;
+        tail = inst.get();
+        ++_size;
+    }
+
+    /**
+     * Remove an instruction from the list.
+     *
+     * @return The reference the list held to the instruction.
+     */
+    Ptr
+    remove(Inst *inst)
+    {
+        auto &l = links(inst);
+        assert(l.linked);
+        Ptr &ref = owner(inst);
+        Ptr removed = std::move(ref);
+        // The removed reference keeps the instruction and its links alive.
+        ref = std::move(l.next);
+        if (ref)
+            links(ref.get()).prev = l.prev;
+        else
+            tail = l.prev;
+        l.prev = nullptr;
+        l.linked = false;
+        --_size;
+        return removed;
+    }
+
+    /** Remove an instruction and return the iterator to the next one. */
+    iterator
+    erase(iterator it)
+    {
+        iterator next = std::next(it);
+        remove(it.get());
+        return next;
+    }
+
+    /** Remove the first instruction and return the list's reference. */
+    Ptr pop_front() { return remove(front().get()); }
+
+    /** Remove the last instruction and return the list's reference. */
+    Ptr pop_back() { return remove(back().get()); }
+
+    void
+    clear()
+    {
+        // Removing from the front one at a time avoids destroying a long
+        // chain of references recursively.
+        while (!empty())
+            pop_front();
+    }
+
+    /** Move all instructions of another list to the end of this one. */
+    void
+    append(InstList &other)
+    {
+        if (other.empty())
+            return;
+        links(other.head.get()).prev = tail;
+        if (tail)
+            links(tail).next = std::move(other.head);
+        else
+            head = std::move(other.head);
+        tail = other.tail;
+        _size += other._size;
+        other.tail = nullptr;
+        other._size = 0;
+    }
+
+  private:
+    static InstListLinks<Inst> &
+    links(Inst *inst)
+    {
+        return inst->instListLinks[Id];
+    }
+
+    /** The reference the list holds to an instruction. */
+    const Ptr &
+    owner(Inst *inst) const
+    {
+        Inst *prev = links(inst).prev;
+        return prev ? links(prev).next : head;
+    }
+
+    Ptr &
+    owner(Inst *inst)
+    {
+        Inst *prev = links(inst).prev;
+        return prev ? links(prev).next : head;
+    }
+
+    Ptr head;
+    Inst *tail = nullptr;
+    size_t _size = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_LIST_HH__
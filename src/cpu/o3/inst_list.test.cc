@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <iterator>
+#include <vector>
+
+#include "cpu/o3/inst_list.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+namespace
+{
+
+int liveInsts = 0;
+
+struct TestInst : public RefCounted
+{
+    explicit TestInst(int _seqNum) : seqNum(_seqNum) { ++liveInsts; }
+    ~TestInst() { --liveInsts; }
+
+    int seqNum;
+    std::array<InstListLinks<TestInst>, NumInstLists> instListLinks;
+};
+
+typedef RefCountingPtr<TestInst> TestInstPtr;
+typedef InstList<TestInst, IQInstList> TestList;
+typedef InstList<TestInst, IQExecuteList> OtherTestList;
+
+std::vector<int>
+seqNums(const TestList &list)
+{
+    std::vector<int> nums;
+    for (const auto &inst: list)
+        nums.push_back(inst->seqNum);
+    return nums;
+}
+
+std::vector<int>
+seqNumsReversed(const TestList &list)
+{
+    std::vector<int> nums;
+    auto it = list.end();
+    while (--it != list.end())
+        nums.push_back((*it)->seqNum);
+    return nums;
+}
+
+void
+fill(TestList &list, int first, int last)
+{
+    for (int i = first; i <= last; ++i)
+        list.push_back(new TestInst(i));
+}
+
+} // anonymous namespace
+
+TEST(InstListTest, PushAndIterate)
+{
+    {
+        TestList list;
+        EXPECT_TRUE(list.empty());
+        EXPECT_EQ(list.begin(), list.end());
+
+        fill(list, 1, 4);
+        EXPECT_FALSE(list.empty());
+        EXPECT_EQ(list.size(), 4);
+        EXPECT_EQ(list.front()->seqNum, 1);
+        EXPECT_EQ(list.back()->seqNum, 4);
+        EXPECT_EQ(seqNums(list), std::vector<int>({1, 2, 3, 4}));
+        EXPECT_EQ(seqNumsReversed(list), std::vector<int>({4, 3, 2, 1}));
+        EXPECT_EQ(liveInsts, 4);
+    }
+    // The list held the only references.
+    EXPECT_EQ(liveInsts, 0);
+}
+
+TEST(InstListTest, PopFrontAndBack)
+{
+    TestList list;
+    fill(list, 1, 3);
+
+    TestInstPtr front = list.pop_front();
+    EXPECT_EQ(front->seqNum, 1);
+    TestInstPtr back = list.pop_back();
+    EXPECT_EQ(back->seqNum, 3);
+    EXPECT_EQ(liveInsts, 3);
+
+    // The popped references were the list's only ones.
+    back = nullptr;
+    EXPECT_EQ(liveInsts, 2);
+
+    EXPECT_EQ(seqNums(list), std::vector<int>({2}));
+    EXPECT_EQ(list.front(), list.back());
+
+    list.pop_back();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(list.size(), 0);
+    EXPECT_EQ(liveInsts, 1);
+
+    // A removed instruction can be added again.
+    list.push_back(front);
+    front = nullptr;
+    EXPECT_EQ(seqNums(list), std::vector<int>({1}));
+    EXPECT_EQ(liveInsts, 1);
+}
+
+TEST(InstListTest, RemoveFromMiddle)
+{
+    TestList list;
+    fill(list, 1, 5);
+
+    TestInstPtr third = *std::next(list.begin(), 2);
+    EXPECT_EQ(third->seqNum, 3);
+    EXPECT_EQ(list.iteratorTo(third.get()), std::next(list.begin(), 2));
+
+    TestInstPtr removed = list.remove(third.get());
+    EXPECT_EQ(removed, third);
+    removed = nullptr;
+    EXPECT_EQ(liveInsts, 5);
+
+    EXPECT_EQ(list.size(), 4);
+    EXPECT_EQ(seqNums(list), std::vector<int>({1, 2, 4, 5}));
+    EXPECT_EQ(seqNumsReversed(list), std::vector<int>({5, 4, 2, 1}));
+
+    third = nullptr;
+    EXPECT_EQ(liveInsts, 4);
+}
+
+TEST(InstListTest, EraseWhileIterating)
+{
+    TestList list;
+    fill(list, 1, 6);
+
+    for (auto it = list.begin(); it != list.end();) {
+        if ((*it)->seqNum % 2)
+            it = list.erase(it);
+        else
+            ++it;
+    }
+    EXPECT_EQ(seqNums(list), std::vector<int>({2, 4, 6}));
+    EXPECT_EQ(liveInsts, 3);
+
+    // Erase from the tail backwards, the way squashing walks the list.
+    auto it = list.end();
+    --it;
+    while (it != list.end() && (*it)->seqNum > 2)
+        list.erase(it--);
+    EXPECT_EQ(seqNums(list), std::vector<int>({2}));
+    EXPECT_EQ(seqNumsReversed(list), std::vector<int>({2}));
+    EXPECT_EQ(liveInsts, 1);
+}
+
+TEST(InstListTest, Append)
+{
+    TestList list, other;
+    fill(list, 1, 2);
+    fill(other, 3, 5);
+
+    list.append(other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(other.size(), 0);
+    EXPECT_EQ(list.size(), 5);
+    EXPECT_EQ(seqNums(list), std::vector<int>({1, 2, 3, 4, 5}));
+    EXPECT_EQ(seqNumsReversed(list), std::vector<int>({5, 4, 3, 2, 1}));
+
+    // Appending to an empty list takes over the whole chain.
+    other.append(list);
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(seqNums(other), std::vector<int>({1, 2, 3, 4, 5}));
+    EXPECT_EQ(other.back()->seqNum, 5);
+
+    // The emptied list is still usable.
+    fill(list, 6, 6);
+    EXPECT_EQ(seqNums(list), std::vector<int>({6}));
+    EXPECT_EQ(liveInsts, 6);
+}
+
+TEST(InstListTest, SeparateLinksPerList)
+{
+    TestList list;
+    OtherTestList other;
+    fill(list, 1, 3);
+    for (const auto &inst: list)
+        other.push_back(inst);
+
+    // Removing from one list leaves the other one intact.
+    list.remove(list.back().get());
+    other.pop_front();
+    EXPECT_EQ(seqNums(list), std::vector<int>({1, 2}));
+    EXPECT_EQ(other.front()->seqNum, 2);
+    EXPECT_EQ(other.back()->seqNum, 3);
+    EXPECT_EQ(liveInsts, 3);
+
+    list.clear();
+    EXPECT_EQ(liveInsts, 2);
+    other.clear();
+    EXPECT_EQ(liveInsts, 0);
+}
+
+TEST(InstListTest, ClearLongList)
+{
+    // Clearing must not release the chain of references recursively.
+    TestList list;
+    fill(list, 1, 1000000);
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(liveInsts, 0);
+}
@@ -662,8 +662,7 @@ DynInstPtr
 InstructionQueue::getInstToExecute()
 {
     assert(!instsToExecute.empty());
-    DynInstPtr inst = std::move(instsToExecute.front());
-    instsToExecute.pop_front();
+    DynInstPtr inst = instsToExecute.pop_front();
     if (inst->isFloating()) {
         iqIOStats.fpInstQueueReads++;
     } else if (inst->isVector()) {
@@ -951,11 +950,8 @@ InstructionQueue::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
         instList[tid].pop_front();
     }
 
@@ -1126,7 +1122,7 @@ InstructionQueue::cacheUnblocked()
 {
     DPRINTF(IQ, "Cache is unblocked, rescheduling blocked memory "
             "instructions\n");
-    retryMemInsts.splice(retryMemInsts.end(), blockedMemInsts);
+    retryMemInsts.append(blockedMemInsts);
     // Get the CPU ticking again
     cpu->wakeCPU();
 }
@@ -1134,12 +1130,10 @@ InstructionQueue::cacheUnblocked()
 DynInstPtr
 InstructionQueue::getDeferredMemInstToExecute()
 {
-    for (ListIt it = deferredMemInsts.begin(); it != deferredMemInsts.end();
+    for (auto it = deferredMemInsts.begin(); it != deferredMemInsts.end();
          ++it) {
         if ((*it)->translationCompleted() || (*it)->isSquashed()) {
-            DynInstPtr mem_inst = std::move(*it);
-            deferredMemInsts.erase(it);
-            return mem_inst;
+            return deferredMemInsts.remove(it.get());
         }
     }
     return nullptr;
@@ -1151,9 +1145,7 @@ InstructionQueue::getBlockedMemInstToExecute()
     if (retryMemInsts.empty()) {
         return nullptr;
     } else {
-        DynInstPtr mem_inst = std::move(retryMemInsts.front());
-        retryMemInsts.pop_front();
-        return mem_inst;
+        return retryMemInsts.pop_front();
     }
 }
 
@@ -1185,7 +1177,7 @@ void
 InstructionQueue::doSquash(ThreadID tid)
 {
     // Start at the tail.
-    ListIt squash_it = instList[tid].end();
+    auto squash_it = instList[tid].end();
     --squash_it;
 
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
@@ -1505,7 +1497,7 @@ InstructionQueue::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        auto inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
@@ -1545,7 +1537,7 @@ InstructionQueue::dumpInsts()
 
     int num = 0;
     int valid_num = 0;
-    ListIt inst_list_it = instsToExecute.begin();
+    auto inst_list_it = instsToExecute.begin();
 
     while (inst_list_it != instsToExecute.end())
     {
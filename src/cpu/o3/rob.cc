@@ -97,6 +97,12 @@ ROB::ROB(CPU *_cpu, const BaseO3CPUParams &params)
         maxEntries[tid] = 0;
     }
 
+    // Any thread may use the whole ROB, depending on the policy
+    instList.reserve(MaxThreads);
+    for (ThreadID tid = 0; tid < MaxThreads; tid++) {
+        instList.emplace_back(tid < numThreads ? numEntries : 0);
+    }
+
     resetState();
 }
 
@@ -105,7 +111,7 @@ ROB::resetState()
 {
     for (ThreadID tid = 0; tid  < MaxThreads; tid++) {
         threadEntries[tid] = 0;
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
         squashedSeqNum[tid] = 0;
         doneSquashing[tid] = true;
     }
@@ -206,6 +212,7 @@ ROB::insertInst(const DynInstPtr &inst)
 
     ThreadID tid = inst->threadNumber;
 
+    assert(!instList[tid].full());
     instList[tid].push_back(inst);
 
     //Set Up head iterator if this is the 1st instruction in the ROB
@@ -237,11 +244,10 @@ ROB::retireHead(ThreadID tid)
 
     assert(numInstsInROB > 0);
 
-    // Get the head ROB instruction by copying it and remove it from the list
-    InstIt head_it = instList[tid].begin();
-
-    DynInstPtr head_inst = std::move(*head_it);
-    instList[tid].erase(head_it);
+    // Get the head ROB instruction by moving it out of the list, which
+    // also drops the reference held by the list entry
+    DynInstPtr head_inst = std::move(instList[tid].front());
+    instList[tid].pop_front();
 
     assert(head_inst->readyToCommit());
 
@@ -312,13 +318,13 @@ ROB::doSquash(ThreadID tid)
     DPRINTF(ROB, "[tid:%i] Squashing instructions until [sn:%llu].\n",
             tid, squashedSeqNum[tid]);
 
-    assert(squashIt[tid] != instList[tid].end());
+    assert(squashIt[tid].dereferenceable());
 
     if ((*squashIt[tid])->seqNum < squashedSeqNum[tid]) {
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
 
         doneSquashing[tid] = true;
         return;
@@ -338,7 +344,7 @@ ROB::doSquash(ThreadID tid)
 
     for (int numSquashed = 0;
          numSquashed < numInstsToSquash &&
-         squashIt[tid] != instList[tid].end() &&
+         squashIt[tid].dereferenceable() &&
          (*squashIt[tid])->seqNum > squashedSeqNum[tid];
          ++numSquashed)
     {
@@ -358,7 +364,7 @@ ROB::doSquash(ThreadID tid)
             DPRINTF(ROB, "Reached head of instruction list while "
                     "squashing.\n");
 
-            squashIt[tid] = instList[tid].end();
+            squashIt[tid] = InstIt();
 
             doneSquashing[tid] = true;
 
@@ -380,7 +386,7 @@ ROB::doSquash(ThreadID tid)
         DPRINTF(ROB, "[tid:%i] Done squashing instructions.\n",
                 tid);
 
-        squashIt[tid] = instList[tid].end();
+        squashIt[tid] = InstIt();
 
         doneSquashing[tid] = true;
     }
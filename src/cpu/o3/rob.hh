@@ -45,6 +45,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
@@ -72,7 +73,7 @@ class ROB
 {
   public:
     typedef std::pair<RegIndex, RegIndex> UnmapInfo;
-    typedef typename std::list<DynInstPtr>::iterator InstIt;
+    typedef CircularQueue<DynInstPtr>::iterator InstIt;
 
     /** Possible ROB statuses. */
     enum Status
@@ -285,8 +286,14 @@ class ROB
     /** Max Insts a Thread Can Have in the ROB */
     unsigned maxEntries[MaxThreads];
 
-    /** ROB List of Instructions */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** ROB List of Instructions. Each thread's list is a circular
+     *  buffer sized to the whole ROB, so no memory is allocated when
+     *  instructions are inserted or retired. There is one list per
+     *  hardware thread context (MaxThreads), built at its size in the
+     *  constructor, and the vector is never resized afterwards since
+     *  the list iterators point into it.
+     */
+    std::vector<CircularQueue<DynInstPtr>> instList;
 
     /** Number of instructions that can be squashed in a single cycle. */
     unsigned squashWidth;
@@ -308,7 +315,8 @@ class ROB
      *  when squashing, the instructions are marked as squashed but not
      *  immediately removed, meaning the tail iterator remains the same before
      *  and after a squash.
-     *  This will always be set to cpu->instList.end() if it is invalid.
+     *  This will always be set to a default constructed iterator if it is
+     *  invalid, as the end of a circular queue moves when it is inserted to.
      */
     InstIt squashIt[MaxThreads];
 
@@ -0,0 +1,54 @@
+# Copyright (c) 2023 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import *
+
+
+class BranchTraceReplayer(SimObject):
+    """Evaluates branch predictors on a trace recorded by a
+    BranchTraceRecorder. Call replay() after instantiation; the number of
+    mispredictions and the MPKI of every predictor are reported in the
+    statistics. The predictors must not be used by a CPU.
+
+    Predictors drawing from the global random number generator, i.e., the
+    TAGE and the perceptron predictors, can only be replayed with
+    num_threads set to 1."""
+
+    type = "BranchTraceReplayer"
+    cxx_header = "cpu/pred/branch_trace_replayer.hh"
+    cxx_class = "gem5::branch_prediction::BranchTraceReplayer"
+
+    cxx_exports = [
+        PyBindMethod("replay"),
+    ]
+
+    predictors = VectorParam.BranchPredictor("Branch predictors to evaluate")
+    trace_file = Param.String("Branch trace (input) file")
+    numThreads = Param.Unsigned(1, "Number of threads of the traced CPU")
+    num_threads = Param.Unsigned(
+        1, "Number of host threads replaying the trace, 0 uses all cores"
+    )
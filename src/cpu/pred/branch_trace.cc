@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace.hh"
+
+#include <cstring>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+const char traceMagic[8] = { 'g', '5', 'B', 'R', 'T', 'R', 'C', '1' };
+
+/** Flags byte of the record terminating a trace. */
+const uint8_t endOfTrace = 0xff;
+
+} // anonymous namespace
+
+BranchTraceWriter::BranchTraceWriter(std::ostream &_os)
+    : os(_os)
+{
+    os.write(traceMagic, sizeof(traceMagic));
+}
+
+void
+BranchTraceWriter::writeVarint(uint64_t value)
+{
+    while (value >= 0x80) {
+        os.put(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    os.put(static_cast<char>(value));
+}
+
+void
+BranchTraceWriter::writeSigned(int64_t value)
+{
+    // Zig-zag encode so small negative deltas stay small.
+    writeVarint((static_cast<uint64_t>(value) << 1) ^
+                static_cast<uint64_t>(value >> 63));
+}
+
+void
+BranchTraceWriter::write(const BranchTraceRecord &record)
+{
+    panic_if(finished, "Writing to a finished branch trace.");
+
+    os.put(static_cast<char>(record.flags));
+    writeVarint(record.insts);
+    writeSigned(record.pc - lastPC);
+    writeSigned(record.target - record.pc);
+    lastPC = record.pc;
+}
+
+void
+BranchTraceWriter::finish(uint64_t insts)
+{
+    if (finished)
+        return;
+
+    os.put(static_cast<char>(endOfTrace));
+    writeVarint(insts);
+    os.flush();
+    finished = true;
+}
+
+BranchTraceReader::BranchTraceReader(std::istream &_is)
+    : is(_is)
+{
+    char magic[sizeof(traceMagic)];
+    is.read(magic, sizeof(magic));
+    fatal_if(!is || std::memcmp(magic, traceMagic, sizeof(magic)) != 0,
+             "Input is not a gem5 branch trace.");
+}
+
+uint64_t
+BranchTraceReader::readVarint()
+{
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        int c = is.get();
+        fatal_if(c == std::istream::traits_type::eof(),
+                 "Truncated branch trace.");
+        value |= static_cast<uint64_t>(c & 0x7f) << shift;
+        if (!(c & 0x80))
+            return value;
+    }
+    fatal("Malformed varint in branch trace.");
+}
+
+int64_t
+BranchTraceReader::readSigned()
+{
+    uint64_t value = readVarint();
+    return static_cast<int64_t>((value >> 1) ^ -(value & 1));
+}
+
+bool
+BranchTraceReader::read(BranchTraceRecord &record)
+{
+    if (done)
+        return false;
+
+    int flags = is.get();
+    if (flags == std::istream::traits_type::eof()) {
+        warn("Branch trace ends without a terminator, it may be "
+             "truncated.");
+        done = true;
+        return false;
+    }
+
+    if (flags == endOfTrace) {
+        tailInsts = readVarint();
+        done = true;
+        return false;
+    }
+
+    record.flags = flags;
+    record.insts = readVarint();
+    record.pc = lastPC + readSigned();
+    record.target = record.pc + readSigned();
+    lastPC = record.pc;
+    return true;
+}
+
+} // namespace branch_prediction
+} // namespace gem5
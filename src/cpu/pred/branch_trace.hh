@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_HH__
+#define __CPU_PRED_BRANCH_TRACE_HH__
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * A committed control instruction as stored in a branch trace. Branch
+ * traces are written by the BranchTraceRecorder probe listener and read
+ * back by the BranchTraceReplayer to evaluate branch predictors offline.
+ */
+struct BranchTraceRecord
+{
+    /** Flags describing the kind of control instruction. */
+    enum Flags : uint8_t
+    {
+        Conditional = 0x01,
+        Indirect = 0x02,
+        Call = 0x04,
+        Return = 0x08,
+        Taken = 0x10
+    };
+
+    /** Address of the branch. */
+    Addr pc = 0;
+    /** Address of the instruction committed after the branch. */
+    Addr target = 0;
+    /** Instructions committed since the previous branch, inclusive. */
+    uint64_t insts = 0;
+    /** A combination of Flags. */
+    uint8_t flags = 0;
+
+    bool isConditional() const { return flags & Conditional; }
+    bool isIndirect() const { return flags & Indirect; }
+    bool isCall() const { return flags & Call; }
+    bool isReturn() const { return flags & Return; }
+    bool taken() const { return flags & Taken; }
+};
+
+/**
+ * Writes a compact binary branch trace. Each record is a flags byte
+ * followed by LEB128 encoded instruction count, PC delta to the previous
+ * branch and target delta to the branch PC, which typically amounts to
+ * four to six bytes per branch. The trace ends with a terminator holding
+ * the instructions committed after the last branch.
+ */
+class BranchTraceWriter
+{
+  public:
+    BranchTraceWriter(std::ostream &os);
+
+    void write(const BranchTraceRecord &record);
+
+    /**
+     * Terminate the trace.
+     * @param insts Instructions committed after the last branch.
+     */
+    void finish(uint64_t insts);
+
+  private:
+    void writeVarint(uint64_t value);
+    void writeSigned(int64_t value);
+
+    std::ostream &os;
+    Addr lastPC = 0;
+    bool finished = false;
+};
+
+/**
+ * Reads a branch trace written by BranchTraceWriter.
+ */
+class BranchTraceReader
+{
+  public:
+    /** Construct a reader, fatal()s if the stream is not a branch trace. */
+    BranchTraceReader(std::istream &is);
+
+    /**
+     * Read the next record.
+     * @return False once the end of the trace has been reached.
+     */
+    bool read(BranchTraceRecord &record);
+
+    /** Instructions committed after the last branch of the trace. */
+    uint64_t trailingInsts() const { return tailInsts; }
+
+  private:
+    uint64_t readVarint();
+    int64_t readSigned();
+
+    std::istream &is;
+    Addr lastPC = 0;
+    uint64_t tailInsts = 0;
+    bool done = false;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_HH__
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "cpu/pred/branch_trace.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+/* Records written to a trace must be read back unchanged. */
+TEST(BranchTraceTest, RoundTrip)
+{
+    std::vector<BranchTraceRecord> records(4);
+    records[0].pc = 0x400100;
+    records[0].target = 0x400080;
+    records[0].insts = 7;
+    records[0].flags = BranchTraceRecord::Conditional |
+                       BranchTraceRecord::Taken;
+    records[1].pc = 0x400084;
+    records[1].target = 0x7fff0000;
+    records[1].insts = 1;
+    records[1].flags = BranchTraceRecord::Call |
+                       BranchTraceRecord::Indirect |
+                       BranchTraceRecord::Taken;
+    records[2].pc = 0x7fff0010;
+    records[2].target = 0x7fff0014;
+    records[2].insts = 123456789;
+    records[2].flags = BranchTraceRecord::Conditional;
+    records[3].pc = 0x7fff0040;
+    records[3].target = 0x400088;
+    records[3].insts = 3;
+    records[3].flags = BranchTraceRecord::Return |
+                       BranchTraceRecord::Indirect |
+                       BranchTraceRecord::Taken;
+
+    std::stringstream stream;
+    BranchTraceWriter writer(stream);
+    for (const auto &record : records)
+        writer.write(record);
+    writer.finish(42);
+
+    BranchTraceReader reader(stream);
+    BranchTraceRecord record;
+    for (const auto &expected : records) {
+        ASSERT_TRUE(reader.read(record));
+        EXPECT_EQ(expected.pc, record.pc);
+        EXPECT_EQ(expected.target, record.target);
+        EXPECT_EQ(expected.insts, record.insts);
+        EXPECT_EQ(expected.flags, record.flags);
+    }
+    EXPECT_FALSE(reader.read(record));
+    EXPECT_EQ(42, reader.trailingInsts());
+}
+
+/* Backward branches to nearby targets must take few bytes. */
+TEST(BranchTraceTest, CompactEncoding)
+{
+    std::stringstream stream;
+    BranchTraceWriter writer(stream);
+    const auto header = stream.str().size();
+
+    BranchTraceRecord record;
+    record.pc = 0x10000;
+    record.target = 0x0fff0;
+    record.insts = 5;
+    record.flags = BranchTraceRecord::Conditional | BranchTraceRecord::Taken;
+    writer.write(record);
+    const auto first = stream.str().size();
+
+    writer.write(record);
+    EXPECT_EQ(4, stream.str().size() - first);
+    EXPECT_GT(first - header, 4);
+}
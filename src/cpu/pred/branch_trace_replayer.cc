@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace_replayer.hh"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <thread>
+
+#include "base/logging.hh"
+#include "cpu/pred/branch_trace.hh"
+#include "cpu/pred/multiperspective_perceptron.hh"
+#include "cpu/pred/tage.hh"
+#include "cpu/static_inst.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/**
+ * Stand-in for the static instruction of a traced branch. Some predictors
+ * look at the kind of control instruction when they are updated.
+ */
+class TraceBranchInst : public StaticInst
+{
+  public:
+    TraceBranchInst(const BranchTraceRecord &record)
+        : StaticInst("branch", No_OpClass)
+    {
+        flags[IsControl] = true;
+        flags[IsCondControl] = record.isConditional();
+        flags[IsUncondControl] = !record.isConditional();
+        flags[IsIndirectControl] = record.isIndirect();
+        flags[IsDirectControl] = !record.isIndirect();
+        flags[IsCall] = record.isCall();
+        flags[IsReturn] = record.isReturn();
+    }
+
+    Fault
+    execute(ExecContext *xc, trace::InstRecord *traceData) const override
+    {
+        panic("Trace branches cannot be executed.");
+    }
+
+    void
+    advancePC(PCStateBase &pc_state) const override
+    {
+        panic("Trace branches cannot be executed.");
+    }
+
+    std::string
+    generateDisassembly(
+            Addr pc, const loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+/**
+ * Whether a predictor draws from the global random number generator,
+ * which is not safe to share between replay threads.
+ */
+bool
+usesGlobalRandom(BPredUnit *bp)
+{
+    return dynamic_cast<TAGE *>(bp) ||
+        dynamic_cast<MultiperspectivePerceptron *>(bp);
+}
+
+} // anonymous namespace
+
+BranchTraceReplayer::BranchTraceReplayer(const Params &p)
+    : SimObject(p),
+      predictors(p.predictors),
+      traceFile(p.trace_file),
+      numThreads(p.num_threads ? p.num_threads :
+                 std::max(1u, std::thread::hardware_concurrency())),
+      stats(this)
+{
+    fatal_if(predictors.empty(), "%s: No branch predictors to evaluate.",
+             name());
+}
+
+BranchTraceReplayer::ReplayStats::ReplayStats(BranchTraceReplayer *parent)
+    : statistics::Group(parent),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions in the branch trace"),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of branches in the branch trace"),
+      ADD_STAT(condBranches, statistics::units::Count::get(),
+               "Number of conditional branches in the branch trace"),
+      ADD_STAT(mispredicted, statistics::units::Count::get(),
+               "Number of mispredicted branches per predictor"),
+      ADD_STAT(mpki, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Count>::get(),
+               "Number of mispredictions per thousand instructions per "
+               "predictor", mispredicted * 1000 / insts)
+{
+    const auto &predictors = parent->predictors;
+    mispredicted.init(predictors.size());
+    for (unsigned i = 0; i < predictors.size(); i++) {
+        mispredicted.subname(i, predictors[i]->name());
+        mpki.subname(i, predictors[i]->name());
+    }
+    mpki.precision(4);
+}
+
+void
+BranchTraceReplayer::replayOn(const std::vector<unsigned> &indices,
+                              std::vector<Result> &results)
+{
+    std::ifstream is(traceFile, std::ios::binary);
+    BranchTraceReader reader(is);
+
+    // Static instructions are reference counted without synchronisation,
+    // so every thread creates its own.
+    std::array<StaticInstPtr, BranchTraceRecord::Taken> insts;
+
+    uint64_t inst_count = 0;
+    uint64_t branch_count = 0;
+    uint64_t cond_count = 0;
+
+    BranchTraceRecord record;
+    while (reader.read(record)) {
+        const uint8_t kind = record.flags & ~BranchTraceRecord::Taken;
+        if (!insts[kind])
+            insts[kind] = new TraceBranchInst(record);
+
+        inst_count += record.insts;
+        ++branch_count;
+        if (record.isConditional())
+            ++cond_count;
+
+        for (auto i : indices) {
+            BPredUnit *bp = predictors[i];
+            void *bp_history = nullptr;
+
+            bool pred_taken = true;
+            if (record.isConditional())
+                pred_taken = bp->lookup(0, record.pc, bp_history);
+            else
+                bp->uncondBranch(0, record.pc, bp_history);
+
+            if (pred_taken != record.taken()) {
+                ++results[i].mispredicted;
+                bp->update(0, record.pc, record.taken(), bp_history, true,
+                           insts[kind], record.target);
+            }
+            bp->update(0, record.pc, record.taken(), bp_history, false,
+                       insts[kind], record.target);
+        }
+    }
+    inst_count += reader.trailingInsts();
+
+    for (auto i : indices) {
+        results[i].insts = inst_count;
+        results[i].branches = branch_count;
+        results[i].condBranches = cond_count;
+    }
+}
+
+void
+BranchTraceReplayer::replay()
+{
+    // Check the trace before starting any thread.
+    {
+        std::ifstream is(traceFile, std::ios::binary);
+        fatal_if(!is, "%s: Unable to open branch trace %s.", name(),
+                 traceFile);
+        BranchTraceReader reader(is);
+    }
+
+    const unsigned num_workers =
+        std::min<unsigned>(numThreads, predictors.size());
+    std::vector<std::vector<unsigned>> work(num_workers);
+    for (unsigned i = 0; i < predictors.size(); i++)
+        work[i % num_workers].push_back(i);
+
+    if (num_workers > 1) {
+        for (auto bp : predictors) {
+            fatal_if(usesGlobalRandom(bp), "%s: %s uses the global random "
+                     "number generator and cannot be replayed on more than "
+                     "one thread. Set num_threads to 1.", name(), bp->name());
+        }
+    }
+
+    inform("%s: Replaying %s on %d predictors using %d threads.", name(),
+           traceFile, predictors.size(), num_workers);
+
+    std::vector<Result> results(predictors.size());
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < num_workers; t++) {
+        threads.emplace_back(&BranchTraceReplayer::replayOn, this,
+                             std::cref(work[t]), std::ref(results));
+    }
+    replayOn(work[0], results);
+    for (auto &thread : threads)
+        thread.join();
+
+    stats.insts += results[0].insts;
+    stats.branches += results[0].branches;
+    stats.condBranches += results[0].condBranches;
+    for (unsigned i = 0; i < predictors.size(); i++) {
+        stats.mispredicted[i] += results[i].mispredicted;
+        inform("%s: %.4f MPKI", predictors[i]->name(),
+               results[i].insts ?
+               1000.0 * results[i].mispredicted / results[i].insts : 0.0);
+    }
+}
+
+} // namespace branch_prediction
+} // namespace gem5
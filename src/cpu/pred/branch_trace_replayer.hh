@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
+#define __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "params/BranchTraceReplayer.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * Evaluates branch predictors on a branch trace recorded by the
+ * BranchTraceRecorder. The trace is replayed independently on every
+ * predictor, which makes it possible to compare many predictor
+ * configurations in a single run without simulating the workload again.
+ * The predictors are split among several host threads, each of them
+ * streaming the trace from disk on its own.
+ *
+ * Only the direction predictors are exercised: predictions are made and
+ * trained in commit order, mispredicted branches first go through the
+ * squash update like they would in an out-of-order core. The BTB,
+ * RAS and indirect predictors are not modelled.
+ */
+class BranchTraceReplayer : public SimObject
+{
+  public:
+    PARAMS(BranchTraceReplayer);
+    BranchTraceReplayer(const Params &p);
+
+    /**
+     * Replay the trace on all predictors and record the results in the
+     * statistics. This returns once all predictors are done.
+     */
+    void replay();
+
+  private:
+    /** Outcome of a replay on a single predictor. */
+    struct Result
+    {
+        uint64_t insts = 0;
+        uint64_t branches = 0;
+        uint64_t condBranches = 0;
+        uint64_t mispredicted = 0;
+    };
+
+    /**
+     * Replay the whole trace on a subset of the predictors.
+     * @param indices Indices of the predictors to replay.
+     * @param results Results, indexed like the predictors.
+     */
+    void replayOn(const std::vector<unsigned> &indices,
+                  std::vector<Result> &results);
+
+    const std::vector<BPredUnit *> predictors;
+    const std::string traceFile;
+    const unsigned numThreads;
+
+    struct ReplayStats : public statistics::Group
+    {
+        ReplayStats(BranchTraceReplayer *parent);
+
+        /** Instructions covered by the trace. */
+        statistics::Scalar insts;
+        /** Branches in the trace. */
+        statistics::Scalar branches;
+        /** Conditional branches in the trace. */
+        statistics::Scalar condBranches;
+        /** Mispredicted branches of each predictor. */
+        statistics::Vector mispredicted;
+        /** Mispredictions per thousand instructions of each predictor. */
+        statistics::Formula mpki;
+    } stats;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
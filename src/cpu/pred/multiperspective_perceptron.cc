@@ -255,24 +255,20 @@ MultiperspectivePerceptron::findBest(ThreadID tid,
     if (threshold < 0) {
         return;
     }
-    struct BestPair
-    {
-        int index;
-        int mpreds;
-        bool operator<(BestPair const &bp) const
-        {
-            return mpreds < bp.mpreds;
-        }
-    };
-    std::vector<BestPair> pairs(best_preds.size());
-    for (int i = 0; i < best_preds.size(); i += 1) {
-        pairs[i].index = i;
-        pairs[i].mpreds = threadData[tid]->mpreds[i];
-    }
-    std::sort(pairs.begin(), pairs.end());
-    for (int i = 0; i < (std::min(nbest, (int) best_preds.size())); i += 1) {
-        best_preds[i] = pairs[i].index;
-    }
+    findBest(threadData[tid]->mpreds, nbest, best_preds);
+}
+
+const std::vector<bool> &
+MultiperspectivePerceptron::getBestTables(ThreadID tid)
+{
+    ThreadData &td = *threadData[tid];
+    if (!td.bestTablesValid) {
+        std::vector<int> best_preds(specs.size(), -1);
+        findBest(tid, best_preds);
+        flagBest(best_preds, nbest, td.bestTables);
+        td.bestTablesValid = true;
+    }
+    return td.bestTables;
 }
 
 unsigned int
@@ -309,9 +305,6 @@ MultiperspectivePerceptron::getIndex(ThreadID tid, const MPPBranchInfo &bi,
 int
 MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
 {
-    // list of best predictors
-    std::vector<int> best_preds(specs.size(), -1);
-
     // initialize sum
     bi.yout = 0;
 
@@ -330,7 +323,7 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     }
     // find the best subset of features to use in case of a low-confidence
     // branch
-    findBest(tid, best_preds);
+    const std::vector<bool> &best_tables = getBestTables(tid);
 
     // begin computation of the sum for low-confidence branch
     int bestval = 0;
@@ -352,16 +345,8 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
         // add the value
         bi.yout += val;
         // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
-            }
+        if (threshold >= 0 && best_tables[i]) {
+            bestval += val;
         }
     }
     // apply a fudge factor to affect when training is triggered
@@ -433,6 +418,7 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
             if (sign) weight = -weight;
             bool pred = weight >= 1;
             if (pred != taken) {
+                threadData[tid]->bestTablesValid = false;
                 mpreds[i] += 1;
                 if (mpreds[i] == (1 << tunebits) - 1) {
                     halve = true;
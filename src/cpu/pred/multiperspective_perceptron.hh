@@ -39,6 +39,7 @@
 #ifndef __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 #define __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
@@ -353,6 +354,12 @@ class MultiperspectivePerceptron : public BPredUnit
         int occupancy;
 
         std::vector<int> mpreds;
+        /**
+         * Whether each table is one of the nbest tables with the fewest
+         * mispredictions. This is only recomputed after mpreds changed.
+         */
+        std::vector<bool> bestTables;
+        bool bestTablesValid = false;
         std::vector<std::vector<short int>> tables;
         std::vector<std::vector<std::array<bool, 2>>> sign_bits;
     };
@@ -456,6 +463,14 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     void findBest(ThreadID tid, std::vector<int> &best_preds) const;
 
+    /**
+     * Get the tables used in case of a low-confidence branch, computing
+     * them if the misprediction counts changed since the last call
+     * @param tid Thread ID of the branch
+     * @return per table flag telling whether it is one of the best tables
+     */
+    const std::vector<bool> &getBestTables(ThreadID tid);
+
     /**
      * Computes the output of the predictor for a given branch and the
      * resulting best value in case the prediction has low confidence
@@ -1056,6 +1071,57 @@ class MultiperspectivePerceptron : public BPredUnit
             const StaticInstPtr & inst,
             Addr corrTarget) override;
     void btbUpdate(ThreadID tid, Addr branch_addr, void* &bp_history) override;
+
+    /**
+     * Orders the tables by their number of mispredictions
+     * @param mpreds number of mispredictions of each table
+     * @param nbest number of tables to order
+     * @param best_preds vector to write the indices of the nbest tables
+     * with the fewest mispredictions to, in order
+     */
+    static void
+    findBest(const std::vector<int> &mpreds, int nbest,
+             std::vector<int> &best_preds)
+    {
+        struct BestPair
+        {
+            int index;
+            int mpreds;
+            bool operator<(BestPair const &bp) const
+            {
+                return mpreds < bp.mpreds;
+            }
+        };
+        std::vector<BestPair> pairs(best_preds.size());
+        for (int i = 0; i < best_preds.size(); i += 1) {
+            pairs[i].index = i;
+            pairs[i].mpreds = mpreds[i];
+        }
+        std::sort(pairs.begin(), pairs.end());
+        for (int i = 0; i < (std::min(nbest, (int) best_preds.size()));
+             i += 1) {
+            best_preds[i] = pairs[i].index;
+        }
+    }
+
+    /**
+     * Flags the tables in a list of best tables written by findBest()
+     * @param best_preds indices of the best tables, or -1
+     * @param nbest number of best tables
+     * @param best_tables per table flag to set
+     */
+    static void
+    flagBest(const std::vector<int> &best_preds, int nbest,
+             std::vector<bool> &best_tables)
+    {
+        best_tables.assign(best_preds.size(), false);
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size());
+             j += 1) {
+            if (best_preds[j] >= 0) {
+                best_tables[best_preds[j]] = true;
+            }
+        }
+    }
 };
 
 } // namespace branch_prediction
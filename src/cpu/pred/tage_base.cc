@@ -370,26 +370,17 @@ TAGEBase::tagePredict(ThreadID tid, Addr branch_pc,
 
         bi->bimodalIndex = bindex(pc);
 
-        bi->hitBank = 0;
-        bi->altBank = 0;
-        //Look for the bank with longest matching history
-        for (int i = nHistoryTables; i > 0; i--) {
-            if (noSkip[i] &&
-                gtable[i][tableIndices[i]].tag == tableTags[i]) {
-                bi->hitBank = i;
-                bi->hitBankIndex = tableIndices[bi->hitBank];
-                break;
-            }
-        }
-        //Look for the alternate bank
-        for (int i = bi->hitBank - 1; i > 0; i--) {
-            if (noSkip[i] &&
-                gtable[i][tableIndices[i]].tag == tableTags[i]) {
-                bi->altBank = i;
-                bi->altBankIndex = tableIndices[bi->altBank];
-                break;
-            }
-        }
+        //Look for the banks with the longest and second longest matching
+        //history
+        findHitBanks(nHistoryTables,
+            [&](int i) {
+                return noSkip[i] &&
+                    gtable[i][tableIndices[i]].tag == tableTags[i];
+            }, bi->hitBank, bi->altBank);
+        if (bi->hitBank > 0)
+            bi->hitBankIndex = tableIndices[bi->hitBank];
+        if (bi->altBank > 0)
+            bi->altBankIndex = tableIndices[bi->altBank];
         //computes the prediction and the alternate prediction
         if (bi->hitBank > 0) {
             if (bi->altBank > 0) {
@@ -71,14 +71,16 @@ class TAGEBase : public SimObject
   protected:
     // Prediction Structures
 
-    // Tage Entry
+    // Tage Entry. The tag comes first so the entry packs into 4 bytes
+    // and more entries of the tagged tables fit in the host caches.
     struct TageEntry
     {
-        int8_t ctr;
         uint16_t tag;
+        int8_t ctr;
         uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
+        TageEntry() : tag(0), ctr(0), u(0) { }
     };
+    static_assert(sizeof(TageEntry) == 4);
 
     // Folded History Table - compressed history
     // to mix with instruction PC to index partially
@@ -420,6 +422,32 @@ class TAGEBase : public SimObject
     bool isSpeculativeUpdateEnabled() const;
     size_t getSizeInBits() const;
 
+    /**
+     * Find the tagged tables with the longest and the second longest
+     * history which hit, in a single pass from the longest table down.
+     * @param n Number of tagged tables, numbered from 1
+     * @param hit Tells whether table i hits
+     * @param hit_bank Set to the longest table which hits, or 0
+     * @param alt_bank Set to the second longest table which hits, or 0
+     */
+    template <class Hit>
+    static void
+    findHitBanks(int n, Hit hit, int &hit_bank, int &alt_bank)
+    {
+        hit_bank = 0;
+        alt_bank = 0;
+        for (int i = n; i > 0; i--) {
+            if (hit(i)) {
+                if (!hit_bank) {
+                    hit_bank = i;
+                } else {
+                    alt_bank = i;
+                    return;
+                }
+            }
+        }
+    }
+
   protected:
     const unsigned logRatioBiModalHystEntries;
     const unsigned nHistoryTables;
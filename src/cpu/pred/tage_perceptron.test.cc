@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks the table lookups of the TAGE and multiperspective perceptron
+ * predictors which were rewritten for host performance against the way
+ * they were computed before, which must give the same predictions.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "cpu/pred/multiperspective_perceptron.hh"
+#include "cpu/pred/tage_base.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+/** The longest and alternate bank search as two passes over the tables. */
+void
+findHitBanksTwoPass(const std::vector<bool> &hits, int &hit_bank,
+                    int &alt_bank)
+{
+    const int n = hits.size() - 1;
+    hit_bank = 0;
+    alt_bank = 0;
+    for (int i = n; i > 0; i--) {
+        if (hits[i]) {
+            hit_bank = i;
+            break;
+        }
+    }
+    for (int i = hit_bank - 1; i > 0; i--) {
+        if (hits[i]) {
+            alt_bank = i;
+            break;
+        }
+    }
+}
+
+/**
+ * The sum of the values of the best tables, looking each table up in the
+ * list of best tables.
+ */
+int
+bestValueSearch(const std::vector<int> &best_preds, int nbest,
+                const std::vector<int> &values)
+{
+    int bestval = 0;
+    for (int i = 0; i < values.size(); i += 1) {
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size());
+             j += 1) {
+            if (best_preds[j] == i) {
+                bestval += values[i];
+                break;
+            }
+        }
+    }
+    return bestval;
+}
+
+} // anonymous namespace
+
+TEST(TageBaseTest, FindHitBanks)
+{
+    std::mt19937_64 rng(0x5eed);
+    // TAGE-SC-L has the most tagged tables, 36.
+    for (int n = 0; n <= 36; n++) {
+        for (int round = 0; round < 1000; round++) {
+            // Make hits rare in some rounds, so that no or one table hits.
+            const int odds = 1 + round % 8;
+            std::vector<bool> hits(n + 1);
+            for (int i = 1; i <= n; i++)
+                hits[i] = rng() % odds == 0;
+
+            int hit_bank, alt_bank, expected_hit, expected_alt;
+            TAGEBase::findHitBanks(n, [&](int i) { return hits[i]; },
+                                   hit_bank, alt_bank);
+            findHitBanksTwoPass(hits, expected_hit, expected_alt);
+            ASSERT_EQ(expected_hit, hit_bank);
+            ASSERT_EQ(expected_alt, alt_bank);
+        }
+    }
+}
+
+TEST(TageBaseTest, FindHitBanksStopsAtAlternate)
+{
+    std::vector<int> asked;
+    int hit_bank, alt_bank;
+    TAGEBase::findHitBanks(10,
+        [&](int i) { asked.push_back(i); return i == 8 || i == 5; },
+        hit_bank, alt_bank);
+    EXPECT_EQ(8, hit_bank);
+    EXPECT_EQ(5, alt_bank);
+    EXPECT_EQ(std::vector<int>({10, 9, 8, 7, 6, 5}), asked);
+}
+
+TEST(MultiperspectivePerceptronTest, BestTables)
+{
+    std::mt19937_64 rng(0x5eed);
+    for (int round = 0; round < 10000; round++) {
+        const int num_tables = 1 + rng() % 40;
+        const int nbest = 1 + rng() % 40;
+        // Few distinct counts, so that many tables tie.
+        const int max_mpreds = 1 + rng() % 64;
+        std::vector<int> mpreds(num_tables), values(num_tables);
+        for (int i = 0; i < num_tables; i++) {
+            mpreds[i] = rng() % max_mpreds;
+            values[i] = int(rng() % 127) - 63;
+        }
+
+        std::vector<int> best_preds(num_tables, -1);
+        MultiperspectivePerceptron::findBest(mpreds, nbest, best_preds);
+        std::vector<bool> best_tables;
+        MultiperspectivePerceptron::flagBest(best_preds, nbest,
+                                             best_tables);
+        ASSERT_EQ(num_tables, best_tables.size());
+
+        int bestval = 0;
+        for (int i = 0; i < num_tables; i++) {
+            if (best_tables[i])
+                bestval += values[i];
+        }
+        ASSERT_EQ(bestValueSearch(best_preds, nbest, values), bestval);
+
+        // The flagged tables are the ones with the fewest mispredictions.
+        int flagged = 0, max_flagged = -1, min_unflagged = max_mpreds;
+        for (int i = 0; i < num_tables; i++) {
+            if (best_tables[i]) {
+                flagged++;
+                max_flagged = std::max(max_flagged, mpreds[i]);
+            } else {
+                min_unflagged = std::min(min_unflagged, mpreds[i]);
+            }
+        }
+        ASSERT_EQ(std::min(nbest, num_tables), flagged);
+        ASSERT_LE(max_flagged, min_unflagged);
+    }
+}
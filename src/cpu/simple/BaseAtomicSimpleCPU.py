@@ -39,6 +39,7 @@
 from m5.params import *
 from m5.objects.BaseSimpleCPU import BaseSimpleCPU
 from m5.objects.SimPoint import SimPoint
+from m5.objects.BranchTraceRecorder import BranchTraceRecorder
 
 
 class BaseAtomicSimpleCPU(BaseSimpleCPU):
@@ -61,8 +62,16 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    basic_block_cache = Param.Bool(
+        False,
+        "Execute instructions from basic blocks decoded earlier instead of "
+        "fetching them again (instruction fetches are not simulated)",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
         simpoint.interval = interval
         self.probeListener = simpoint
+
+    def addBranchTraceProbe(self, trace_file="branch.trace"):
+        self.branchTraceRecorder = BranchTraceRecorder(trace_file=trace_file)
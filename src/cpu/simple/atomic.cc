@@ -42,6 +42,7 @@
 #include "cpu/simple/atomic.hh"
 
 #include "arch/generic/decoder.hh"
+#include "base/intmath.hh"
 #include "base/output.hh"
 #include "cpu/exetrace.hh"
 #include "cpu/utils.hh"
@@ -78,6 +79,9 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      basicBlockCache(p.basic_block_cache), basicBlocks(numThreads),
+      curBlock(nullptr), curBlockInst(0), prevBlock(nullptr),
+      blockFetchLast(0), blockFetchCacheable(true),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
@@ -88,6 +92,10 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
     data_read_req = std::make_shared<Request>();
     data_write_req = std::make_shared<Request>();
     data_amo_req = std::make_shared<Request>();
+
+    fatal_if(basicBlockCache && simulate_inst_stalls,
+             "%s: basic_block_cache skips instruction fetches and cannot "
+             "simulate icache stalls.", name());
 }
 
 
@@ -148,6 +156,9 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed behind our back while drained.
+    invalidateBasicBlocks();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -193,6 +204,8 @@ AtomicSimpleCPU::switchOut()
 {
     BaseSimpleCPU::switchOut();
 
+    invalidateBasicBlocks();
+
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isCpuDrained());
@@ -204,6 +217,8 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *old_cpu)
 {
     BaseSimpleCPU::takeOverFrom(old_cpu);
 
+    invalidateBasicBlocks();
+
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
 }
@@ -294,6 +309,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
     if (pkt->isInvalidate() || pkt->isWrite()) {
         DPRINTF(SimpleCPU, "received invalidation for addr:%#x\n",
                 pkt->getAddr());
+        cpu->invalidateBasicBlocks(pkt->getAddr(), pkt->getSize());
         for (auto &t_info : cpu->threadInfo) {
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
@@ -316,10 +332,16 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
         }
     }
 
-    // if snoop invalidates, release any associated locks
-    if (pkt->isInvalidate()) {
+    // functional writes (e.g., from a debugger or a DMA device
+    // without caches) may modify code held in basic blocks
+    if (pkt->isInvalidate() || pkt->isWrite()) {
         DPRINTF(SimpleCPU, "received invalidation for addr:%#x\n",
                 pkt->getAddr());
+        cpu->invalidateBasicBlocks(pkt->getAddr(), pkt->getSize());
+    }
+
+    // if snoop invalidates, release any associated locks
+    if (pkt->isInvalidate()) {
         for (auto &t_info : cpu->threadInfo) {
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
@@ -503,6 +525,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+                    invalidateBasicBlocks(req->getPaddr(), req->getSize());
                 }
                 dcache_access = true;
                 panic_if(pkt.isError(), "Data write (%s) failed: %s",
@@ -590,6 +613,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            invalidateBasicBlocks(req->getPaddr(), req->getSize());
         }
 
         dcache_access = true;
@@ -623,6 +647,10 @@ AtomicSimpleCPU::tick()
         data_read_req->setContext(cid);
         data_write_req->setContext(cid);
         data_amo_req->setContext(cid);
+
+        // The block being executed belongs to the previous thread.
+        curBlock = nullptr;
+        prevBlock = nullptr;
     }
 
     SimpleExecContext &t_info = *threadInfo[curThread];
@@ -652,7 +680,39 @@ AtomicSimpleCPU::tick()
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
-        if (needToFetch) {
+
+        // Instructions of a basic block have been fetched and decoded
+        // already. Only the first instruction of a block is translated,
+        // which makes remaps and TLB invalidations take effect the next
+        // time the block is entered.
+        const BasicBlock::Inst *block_inst = nullptr;
+        bool translated = false;
+        if (basicBlockCache && needToFetch && t_info.fetchOffset == 0) {
+            block_inst = nextBlockInst(pc);
+            if (!block_inst && !curBlock) {
+                ifetch_req->taskId(taskId());
+                setupFetchRequest(ifetch_req);
+                fault = thread->mmu->translateAtomic(ifetch_req,
+                        thread->getTC(), BaseMMU::Execute);
+                translated = true;
+                if (fault == NoFault)
+                    block_inst = enterBlock(pc);
+            }
+
+            if (block_inst) {
+                needToFetch = false;
+            } else {
+                // The decoder may not have seen the instructions executed
+                // from blocks, so start it afresh as after a fault.
+                thread->decoder->reset();
+                set(blockFetchPC, pc);
+                blockFetchLines.clear();
+                blockFetchLast = 0;
+                blockFetchCacheable = true;
+            }
+        }
+
+        if (needToFetch && !translated) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
             fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
@@ -674,10 +734,20 @@ AtomicSimpleCPU::tick()
                 //{
                     icache_access = true;
                     icache_latency = fetchInstMem();
+                    if (basicBlockCache)
+                        recordBlockFetch();
                 //}
             }
 
-            preExecute();
+            if (block_inst) {
+                preExecute(block_inst->inst, *block_inst->decodedPC);
+            } else {
+                preExecute();
+                if (basicBlockCache && needToFetch && !t_info.stayAtPC) {
+                    appendBlockInst(curMacroStaticInst ?
+                            curMacroStaticInst : curStaticInst);
+                }
+            }
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
@@ -723,6 +793,17 @@ AtomicSimpleCPU::tick()
             }
 
         }
+
+        // Anything that may change the state the decoder depends on or
+        // how code is mapped (e.g., mode switches, TLB maintenance,
+        // system calls) drops all basic blocks.
+        if (basicBlockCache && (fault != NoFault || (curStaticInst &&
+                (curStaticInst->isSerializing() ||
+                 curStaticInst->isSquashAfter() ||
+                 curStaticInst->isNonSpeculative())))) {
+            invalidateBasicBlocks();
+        }
+
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
     }
@@ -738,6 +819,158 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+const AtomicSimpleCPU::BasicBlock::Inst *
+AtomicSimpleCPU::nextBlockInst(const PCStateBase &pc)
+{
+    if (!curBlock)
+        return nullptr;
+
+    if (curBlockInst < curBlock->insts.size()) {
+        const auto &inst = curBlock->insts[curBlockInst];
+        if (inst.fetchPC->equals(pc)) {
+            curBlockInst++;
+            return &inst;
+        }
+        // An interrupt or a PC event moved the thread off the block.
+        curBlock = nullptr;
+        prevBlock = nullptr;
+    } else if (curBlock->ended()) {
+        prevBlock = curBlock;
+        curBlock = nullptr;
+    }
+
+    // If curBlock is still set, the next instruction is decoded and
+    // appended to it.
+    return nullptr;
+}
+
+const AtomicSimpleCPU::BasicBlock::Inst *
+AtomicSimpleCPU::enterBlock(const PCStateBase &pc)
+{
+    BasicBlock *prev = prevBlock;
+    prevBlock = nullptr;
+
+    // Uncacheable code, e.g., in a boot ROM or a device, is fetched
+    // from memory every time.
+    if (ifetch_req->isUncacheable() || ifetch_req->isLocalAccess())
+        return nullptr;
+
+    const Addr paddr =
+        ifetch_req->getPaddr() + pc.instAddr() - ifetch_req->getVaddr();
+    const bool secure = ifetch_req->isSecure();
+
+    auto &blocks = basicBlocks[curThread];
+    BasicBlock *block = nullptr;
+    if (prev && prev->next && prev->next->startsAt(pc, paddr, secure)) {
+        block = prev->next;
+    } else {
+        auto it = blocks.find(paddr);
+        if (it != blocks.end() && it->second.startsAt(pc, paddr, secure)) {
+            block = &it->second;
+            if (prev)
+                prev->next = block;
+        }
+    }
+
+    if (block) {
+        curBlock = block;
+        curBlockInst = 1;
+        return &block->insts.front();
+    }
+
+    if (blocks.size() >= maxBasicBlocks)
+        invalidateBasicBlocks();
+
+    // Start a new block, replacing any block at the same address that
+    // was decoded in a different mode or through a different mapping.
+    // Blocks chained to the old contents check the start PC before
+    // following the link.
+    BasicBlock &new_block = blocks[paddr];
+    new_block.paddr = paddr;
+    new_block.secure = secure;
+    new_block.insts.clear();
+    new_block.next = nullptr;
+    curBlock = &new_block;
+    curBlockInst = 0;
+    return nullptr;
+}
+
+void
+AtomicSimpleCPU::recordBlockFetch()
+{
+    if (ifetch_req->isUncacheable() || ifetch_req->isLocalAccess())
+        blockFetchCacheable = false;
+
+    const Addr vaddr = ifetch_req->getVaddr();
+    const Addr last = vaddr + ifetch_req->getSize() - 1;
+    if (last > blockFetchLast)
+        blockFetchLast = last;
+
+    const Addr paddr = ifetch_req->getPaddr();
+    const Addr mask = ~Addr(cacheLineSize() - 1);
+    blockFetchLines.push_back(paddr & mask);
+    blockFetchLines.push_back((paddr + ifetch_req->getSize() - 1) & mask);
+}
+
+void
+AtomicSimpleCPU::appendBlockInst(const StaticInstPtr &inst)
+{
+    if (!curBlock || curBlockInst != curBlock->insts.size())
+        return;
+
+    // Only the first instruction of a block is translated when the
+    // block is entered, so all of the block has to be on its page.
+    const Addr first = curBlock->insts.empty() ?
+        blockFetchPC->instAddr() : curBlock->insts.front().fetchPC->instAddr();
+    const Addr page = roundDown(first, minPageBytes);
+    if (!blockFetchCacheable ||
+            roundDown(blockFetchPC->instAddr(), minPageBytes) != page ||
+            roundDown(blockFetchLast, minPageBytes) != page) {
+        // The block ends before this instruction. An empty block stays
+        // in the map, where it is replaced by the next block there.
+        curBlock = nullptr;
+        return;
+    }
+
+    basicBlockLines.insert(blockFetchLines.begin(), blockFetchLines.end());
+
+    const PCStateBase &decoded_pc = threadInfo[curThread]->thread->pcState();
+    curBlock->insts.push_back({std::move(blockFetchPC),
+            std::unique_ptr<PCStateBase>(decoded_pc.clone()), inst});
+    curBlockInst++;
+}
+
+void
+AtomicSimpleCPU::invalidateBasicBlocks()
+{
+    curBlock = nullptr;
+    prevBlock = nullptr;
+
+    // Clearing touches every bucket, so only clear what is in use.
+    for (auto &blocks : basicBlocks) {
+        if (!blocks.empty())
+            blocks.clear();
+    }
+    if (!basicBlockLines.empty())
+        basicBlockLines.clear();
+}
+
+void
+AtomicSimpleCPU::invalidateBasicBlocks(Addr addr, unsigned size)
+{
+    if (basicBlockLines.empty())
+        return;
+
+    const Addr line_size = cacheLineSize();
+    for (Addr line = roundDown(addr, line_size); line < addr + size;
+            line += line_size) {
+        if (basicBlockLines.count(line)) {
+            invalidateBasicBlocks();
+            return;
+        }
+    }
+}
+
 Tick
 AtomicSimpleCPU::fetchInstMem()
 {
@@ -41,6 +41,11 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
@@ -67,6 +72,131 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /**
+     * Execute instructions from basic blocks decoded earlier instead of
+     * translating, fetching and decoding every instruction again.
+     */
+    const bool basicBlockCache;
+
+    /** Maximum number of instructions in a basic block. */
+    static constexpr size_t maxBasicBlockInsts = 64;
+
+    /** Number of blocks per thread above which all blocks are dropped. */
+    static constexpr size_t maxBasicBlocks = 1 << 16;
+
+    /**
+     * Blocks do not cross boundaries of the smallest page size any ISA
+     * uses, so translating their first instruction covers all of them.
+     */
+    static constexpr Addr minPageBytes = 4096;
+
+    /**
+     * A run of consecutive instructions that have already been fetched
+     * and decoded. A block ends at a control instruction or after
+     * maxBasicBlockInsts instructions, and stops growing at an
+     * uncacheable fetch or at a page boundary.
+     */
+    struct BasicBlock
+    {
+        struct Inst
+        {
+            /** PC state the instruction was fetched with. */
+            std::unique_ptr<PCStateBase> fetchPC;
+            /** PC state the decoder returned for the instruction. */
+            std::unique_ptr<PCStateBase> decodedPC;
+            /** The decoded instruction, which may be a macroop. */
+            StaticInstPtr inst;
+        };
+
+        /** Physical address and security state of the first instruction. */
+        Addr paddr = 0;
+        bool secure = false;
+
+        std::vector<Inst> insts;
+
+        /** The block that followed this one when it was last left. */
+        BasicBlock *next = nullptr;
+
+        bool
+        startsAt(const PCStateBase &pc, Addr _paddr, bool _secure) const
+        {
+            return paddr == _paddr && secure == _secure && !insts.empty() &&
+                insts.front().fetchPC->equals(pc);
+        }
+
+        bool
+        ended() const
+        {
+            return insts.size() >= maxBasicBlockInsts ||
+                (!insts.empty() && insts.back().inst->isControl());
+        }
+    };
+
+    /**
+     * Basic blocks of each thread keyed by the physical address of their
+     * first instruction.
+     */
+    std::vector<std::unordered_map<Addr, BasicBlock>> basicBlocks;
+
+    /** Physical addresses of the cache lines holding cached code. */
+    std::unordered_set<Addr> basicBlockLines;
+
+    /** The block being executed or extended. */
+    BasicBlock *curBlock;
+
+    /** Index of the next instruction of curBlock. */
+    size_t curBlockInst;
+
+    /** The block just left at its end, to chain to the next one. */
+    BasicBlock *prevBlock;
+
+    /** PC state the instruction being decoded was fetched with. */
+    std::unique_ptr<PCStateBase> blockFetchPC;
+
+    /** Cache lines read to fetch the instruction being decoded. */
+    std::vector<Addr> blockFetchLines;
+
+    /** Last virtual address read to fetch the instruction. */
+    Addr blockFetchLast;
+
+    /** False if any part of the instruction was fetched uncacheable. */
+    bool blockFetchCacheable;
+
+    /**
+     * Find the already decoded instruction at pc in curBlock.
+     *
+     * @return The instruction, or nullptr if the thread left curBlock or
+     * reached its end. curBlock is still set if the instruction has to
+     * be decoded and appended to it, and cleared if the next block has
+     * to be entered.
+     */
+    const BasicBlock::Inst *nextBlockInst(const PCStateBase &pc);
+
+    /**
+     * Enter the block starting at pc, which ifetch_req has just been
+     * translated for, following the chain from the previous block before
+     * looking the physical address up.
+     *
+     * @return The first instruction of the block, or nullptr if it has
+     * to be decoded, in which case it starts a new block.
+     */
+    const BasicBlock::Inst *enterBlock(const PCStateBase &pc);
+
+    /** Note the physical address of the last instruction fetch. */
+    void recordBlockFetch();
+
+    /** Append the instruction preExecute() just decoded to curBlock. */
+    void appendBlockInst(const StaticInstPtr &inst);
+
+    /** Drop all basic blocks. */
+    void invalidateBasicBlocks();
+
+    /**
+     * Drop all basic blocks if any of them holds code in the physical
+     * address range [addr, addr + size).
+     */
+    void invalidateBasicBlocks(Addr addr, unsigned size);
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -141,7 +271,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     {
 
       public:
-        AtomicCPUDPort(const std::string &_name, BaseSimpleCPU *_cpu)
+        AtomicCPUDPort(const std::string &_name, AtomicSimpleCPU *_cpu)
             : AtomicCPUPort(_name), cpu(_cpu)
         {
             cacheBlockMask = ~(cpu->cacheLineSize() - 1);
@@ -151,7 +281,7 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
         Addr cacheBlockMask;
       protected:
-        BaseSimpleCPU *cpu;
+        AtomicSimpleCPU *cpu;
 
         virtual Tick recvAtomicSnoop(PacketPtr pkt);
         virtual void recvFunctionalSnoop(PacketPtr pkt);
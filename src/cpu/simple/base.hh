@@ -132,11 +132,28 @@ class BaseSimpleCPU : public BaseCPU
 
     std::unique_ptr<PCStateBase> preExecuteTempPC;
 
+    /**
+     * Trace, predict and count the instruction preExecute() has just
+     * set up.
+     */
+    void preExecuteFetched();
+
   public:
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
     void serviceInstCountEvents();
     void preExecute();
+
+    /**
+     * Set up an instruction decoded earlier instead of fetching and
+     * decoding it again.
+     *
+     * @param inst The decoded instruction, which may be a macroop.
+     * @param decoded_pc The PC state the decoder returned for it.
+     */
+    void preExecute(const StaticInstPtr &inst,
+                    const PCStateBase &decoded_pc);
+
     void postExecute();
     void advancePC(const Fault &fault);
 
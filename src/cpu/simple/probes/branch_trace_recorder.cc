@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/probes/branch_trace_recorder.hh"
+
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+BranchTraceRecorder::BranchTraceRecorder(const BranchTraceRecorderParams &p)
+    : ProbeListenerObject(p),
+      traceStream(nullptr),
+      hasPending(false),
+      instCount(0)
+{
+    // The trace format is already compact, skip gzip to keep the file
+    // readable by the replayer.
+    traceStream = simout.create(p.trace_file, true, true);
+    if (!traceStream)
+        fatal("unable to open branch trace_file");
+
+    writer.reset(
+        new branch_prediction::BranchTraceWriter(*traceStream->stream()));
+
+    // SimObjects are not destroyed when the simulator exits, terminate
+    // the trace from an exit callback instead.
+    registerExitCallback([this]() { finish(); });
+}
+
+BranchTraceRecorder::~BranchTraceRecorder()
+{
+    finish();
+    simout.close(traceStream);
+}
+
+void
+BranchTraceRecorder::finish()
+{
+    if (!writer)
+        return;
+
+    // The successor of the last branch never committed.
+    flush(pending.pc);
+    writer->finish(instCount);
+    writer.reset();
+}
+
+void
+BranchTraceRecorder::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTraceRecorder,
+                             std::pair<SimpleThread*, StaticInstPtr>>
+        BranchTraceListener;
+    listeners.push_back(new BranchTraceListener(this, "Commit",
+                                                &BranchTraceRecorder::record));
+}
+
+void
+BranchTraceRecorder::flush(Addr target)
+{
+    if (!hasPending)
+        return;
+
+    pending.target = target;
+    writer->write(pending);
+    hasPending = false;
+}
+
+void
+BranchTraceRecorder::record(const std::pair<SimpleThread*, StaticInstPtr>& p)
+{
+    SimpleThread* thread = p.first;
+    const StaticInstPtr &inst = p.second;
+
+    if (!writer || (inst->isMicroop() && !inst->isLastMicroop()))
+        return;
+
+    flush(thread->pcState().instAddr());
+
+    ++instCount;
+
+    if (!inst->isControl())
+        return;
+
+    using branch_prediction::BranchTraceRecord;
+
+    pending.pc = thread->pcState().instAddr();
+    pending.insts = instCount;
+    pending.flags = 0;
+    if (inst->isCondCtrl())
+        pending.flags |= BranchTraceRecord::Conditional;
+    if (inst->isIndirectCtrl())
+        pending.flags |= BranchTraceRecord::Indirect;
+    if (inst->isCall())
+        pending.flags |= BranchTraceRecord::Call;
+    if (inst->isReturn())
+        pending.flags |= BranchTraceRecord::Return;
+    if (thread->pcState().branching())
+        pending.flags |= BranchTraceRecord::Taken;
+    hasPending = true;
+    instCount = 0;
+}
+
+} // namespace gem5
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_PROBES_BRANCH_TRACE_RECORDER_HH__
+#define __CPU_SIMPLE_PROBES_BRANCH_TRACE_RECORDER_HH__
+
+#include <memory>
+
+#include "base/output.hh"
+#include "cpu/pred/branch_trace.hh"
+#include "cpu/simple_thread.hh"
+#include "params/BranchTraceRecorder.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+/**
+ * Probe listener writing the committed control instructions of a CPU to
+ * a branch trace. The trace can be replayed on any number of branch
+ * predictors with the BranchTraceReplayer, without simulating the rest
+ * of the system again.
+ */
+class BranchTraceRecorder : public ProbeListenerObject
+{
+  public:
+    BranchTraceRecorder(const BranchTraceRecorderParams &params);
+    virtual ~BranchTraceRecorder();
+
+    virtual void regProbeListeners();
+
+    /**
+     * Called for every committed instruction. Control instructions are
+     * buffered until the next instruction commits since its PC is the
+     * resolved target of the branch.
+     */
+    void record(const std::pair<SimpleThread*, StaticInstPtr>&);
+
+  private:
+    /** Write the buffered branch, if any, to the trace. */
+    void flush(Addr target);
+
+    /** Terminate the trace, further commits are ignored. */
+    void finish();
+
+    /** Pointer to the trace output stream */
+    OutputStream *traceStream;
+
+    std::unique_ptr<branch_prediction::BranchTraceWriter> writer;
+
+    /** Branch waiting for the PC of its successor */
+    branch_prediction::BranchTraceRecord pending;
+    bool hasPending;
+
+    /** Instructions committed since the last recorded branch */
+    uint64_t instCount;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_PROBES_BRANCH_TRACE_RECORDER_HH__
@@ -77,6 +77,16 @@ class TraceCPU(BaseCPU):
         1.0, "Multiplier scale the Trace CPU frequency up or down"
     )
 
+    # The traces are decoded ahead of the simulation by a background thread
+    # per trace. Setting the number of batches to 0 decodes the traces in the
+    # simulation thread instead.
+    readAheadBatches = Param.Unsigned(
+        4, "Number of batches of trace records decoded ahead of time"
+    )
+    readAheadBatchSize = Param.Unsigned(
+        1024, "Number of trace records in a read-ahead batch"
+    )
+
     # Enable exiting when any one Trace CPU completes execution which is set to
     # false by default
     enableEarlyExit = Param.Bool(
@@ -54,7 +54,8 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
         dataRequestorID(params.system->getRequestorId(this, "data")),
         instTraceFile(params.instTraceFile),
         dataTraceFile(params.dataTraceFile),
-        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile),
+        icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile,
+                  params),
         dcacheGen(*this, ".dside", dcachePort, dataRequestorID, dataTraceFile,
                   params),
         icacheNextEvent([this]{ schedIcacheNext(); }, name()),
@@ -311,13 +312,11 @@ TraceCPU::ElasticDataGen::readNextWindow()
     uint32_t num_read = 0;
     while (num_read != windowSize) {
 
-        // Create a new graph node
-        GraphNode* new_node = new GraphNode;
-
-        // Read the next line to get the next record. If that fails then end of
+        // Get the next record as a new graph node. If that fails then end of
         // trace has been reached and traceComplete needs to be set in addition
         // to returning false.
-        if (!trace.read(new_node)) {
+        GraphNode* new_node = trace.read();
+        if (!new_node) {
             DPRINTF(TraceCPUData, "\tTrace complete!\n");
             traceComplete = true;
             return false;
@@ -1195,10 +1194,14 @@ TraceCPU::DcachePort::recvReqRetry()
 }
 
 TraceCPU::ElasticDataGen::InputStream::InputStream(
-        const std::string& filename, const double time_multiplier) :
+        const std::string& filename, const double time_multiplier,
+        const TraceCPUParams &params) :
     trace(filename),
     timeMultiplier(time_multiplier),
-    microOpCount(0)
+    microOpCount(0),
+    readAhead([this](std::unique_ptr<GraphNode> &element)
+              { return readRecord(element); },
+              params.readAheadBatchSize, params.readAheadBatches)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::InstDepRecordHeader header_msg;
@@ -1219,14 +1222,28 @@ TraceCPU::ElasticDataGen::InputStream::InputStream(
 void
 TraceCPU::ElasticDataGen::InputStream::reset()
 {
-    trace.reset();
+    readAhead.reset([this]() { trace.reset(); });
+}
+
+TraceCPU::ElasticDataGen::GraphNode *
+TraceCPU::ElasticDataGen::InputStream::read()
+{
+    std::unique_ptr<GraphNode> element;
+    if (readAhead.read(element))
+        return element.release();
+
+    // We have reached the end of the file
+    return nullptr;
 }
 
 bool
-TraceCPU::ElasticDataGen::InputStream::read(GraphNode* element)
+TraceCPU::ElasticDataGen::InputStream::readRecord(
+        std::unique_ptr<GraphNode> &element)
 {
     ProtoMessage::InstDepRecord pkt_msg;
     if (trace.read(pkt_msg)) {
+        element.reset(new GraphNode);
+
         // Required fields
         element->seqNum = pkt_msg.seq_num();
         element->type = pkt_msg.type();
@@ -1378,8 +1395,11 @@ TraceCPU::ElasticDataGen::GraphNode::typeToStr() const
     return Record::RecordType_Name(type);
 }
 
-TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceCPU::FixedRetryGen::InputStream::InputStream(
+        const std::string& filename, const TraceCPUParams &params) :
+    trace(filename),
+    readAhead([this](TraceElement &element) { return readMessage(element); },
+              params.readAheadBatchSize, params.readAheadBatches)
 {
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
@@ -1396,20 +1416,26 @@ TraceCPU::FixedRetryGen::InputStream::InputStream(const std::string& filename)
 void
 TraceCPU::FixedRetryGen::InputStream::reset()
 {
-    trace.reset();
+    readAhead.reset([this]() { trace.reset(); });
 }
 
 bool
 TraceCPU::FixedRetryGen::InputStream::read(TraceElement* element)
+{
+    return readAhead.read(*element);
+}
+
+bool
+TraceCPU::FixedRetryGen::InputStream::readMessage(TraceElement &element)
 {
     ProtoMessage::Packet pkt_msg;
     if (trace.read(pkt_msg)) {
-        element->cmd = pkt_msg.cmd();
-        element->addr = pkt_msg.addr();
-        element->blocksize = pkt_msg.size();
-        element->tick = pkt_msg.tick();
-        element->flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
-        element->pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
+        element.cmd = pkt_msg.cmd();
+        element.addr = pkt_msg.addr();
+        element.blocksize = pkt_msg.size();
+        element.tick = pkt_msg.tick();
+        element.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
+        element.pc = pkt_msg.has_pc() ? pkt_msg.pc() : 0;
         return true;
     }
 
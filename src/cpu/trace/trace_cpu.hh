@@ -38,14 +38,17 @@
 #ifndef __CPU_TRACE_TRACE_CPU_HH__
 #define __CPU_TRACE_TRACE_CPU_HH__
 
+#include <atomic>
 #include <cstdint>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
 #include <unordered_map>
 
 #include "base/statistics.hh"
 #include "cpu/base.hh"
+#include "cpu/trace/trace_read_ahead.hh"
 #include "debug/TraceCPUData.hh"
 #include "debug/TraceCPUInst.hh"
 #include "params/TraceCPU.hh"
@@ -377,13 +380,26 @@ class TraceCPU : public BaseCPU
             // Input file stream for the protobuf trace
             ProtoInputStream trace;
 
+            /** Decodes the trace ahead of the simulation */
+            TraceReadAhead<TraceElement> readAhead;
+
+            /**
+             * Read and decode the next message of the trace.
+             *
+             * @param element Trace element to populate
+             * @return True if an element could be read successfully
+             */
+            bool readMessage(TraceElement &element);
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
+             * @param params Parameters of the Trace CPU
              */
-            InputStream(const std::string& filename);
+            InputStream(const std::string& filename,
+                        const TraceCPUParams &params);
 
             /**
              * Reset the stream such that it can be played once
@@ -406,11 +422,12 @@ class TraceCPU : public BaseCPU
         /* Constructor */
         FixedRetryGen(TraceCPU& _owner, const std::string& _name,
                    RequestPort& _port, RequestorID requestor_id,
-                   const std::string& trace_file) :
+                   const std::string& trace_file,
+                   const TraceCPUParams &params) :
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file),
+            trace(trace_file, params),
             genName(owner.name() + ".fixedretry." + _name),
             retryPkt(nullptr),
             delta(0),
@@ -772,8 +789,12 @@ class TraceCPU : public BaseCPU
              */
             const double timeMultiplier;
 
-            /** Count of committed ops read from trace plus the filtered ops */
-            uint64_t microOpCount;
+            /**
+             * Count of committed ops read from trace plus the filtered ops.
+             * The trace may be decoded ahead of the simulation, so this
+             * can be larger than the number of ops replayed so far.
+             */
+            std::atomic<uint64_t> microOpCount;
 
             /**
              * The window size that is read from the header of the protobuf
@@ -781,15 +802,28 @@ class TraceCPU : public BaseCPU
              */
             uint32_t windowSize;
 
+            /** Decodes the trace into graph nodes ahead of the simulation */
+            TraceReadAhead<std::unique_ptr<GraphNode>> readAhead;
+
+            /**
+             * Read the next record of the trace and build a graph node.
+             *
+             * @param element Set to the new graph node
+             * @return True if an element could be read successfully
+             */
+            bool readRecord(std::unique_ptr<GraphNode> &element);
+
           public:
             /**
              * Create a trace input stream for a given file name.
              *
              * @param filename Path to the file to read from
              * @param time_multiplier used to scale the compute delays
+             * @param params Parameters of the Trace CPU
              */
             InputStream(const std::string& filename,
-                        const double time_multiplier);
+                        const double time_multiplier,
+                        const TraceCPUParams &params);
 
             /**
              * Reset the stream such that it can be played once
@@ -802,11 +836,10 @@ class TraceCPU : public BaseCPU
              * and also notify the caller if the end of the file
              * was reached.
              *
-             * @param element Trace element to populate
-             * @param size of register dependency array stored in the element
-             * @return True if an element could be read successfully
+             * @return The next graph node, owned by the caller, or
+             * nullptr if the end of the file was reached
              */
-            bool read(GraphNode* element);
+            GraphNode *read();
 
             /** Get window size from trace */
             uint32_t getWindowSize() const { return windowSize; }
@@ -824,7 +857,7 @@ class TraceCPU : public BaseCPU
             owner(_owner),
             port(_port),
             requestorId(requestor_id),
-            trace(trace_file, 1.0 / params.freqMultiplier),
+            trace(trace_file, 1.0 / params.freqMultiplier, params),
             genName(owner.name() + ".elastic." + _name),
             retryPkt(nullptr),
             traceComplete(false),
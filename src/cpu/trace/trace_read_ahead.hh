@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TRACE_TRACE_READ_AHEAD_HH__
+#define __CPU_TRACE_TRACE_READ_AHEAD_HH__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * Decode the elements of a trace ahead of time in a background thread.
+ *
+ * The background thread calls the read function to decode batches of
+ * elements and queues up to a configurable number of batches. The
+ * simulation thread then only has to move elements out of a decoded batch,
+ * so the cost of reading and parsing a trace overlaps with the simulation.
+ * If the number of batches is zero, the read function is called directly
+ * by read() and no thread is created.
+ *
+ * The read function is only ever called from one thread at a time, but
+ * it may be a different thread than the one calling read(). It must not
+ * touch any state used by the simulation. The thread is started on the
+ * first call to read(), so the owner can finish its setup (e.g., read the
+ * trace header) after constructing this object.
+ */
+template <typename T>
+class TraceReadAhead
+{
+  public:
+    /** Read the next element, returns false at the end of the trace */
+    typedef std::function<bool(T &)> ReadFunc;
+
+    /**
+     * @param read_func Function decoding the next element of the trace
+     * @param batch_size Number of elements decoded in one go
+     * @param max_batches Maximum number of batches decoded ahead
+     */
+    TraceReadAhead(ReadFunc read_func, size_t batch_size,
+                   size_t max_batches)
+        : readFunc(std::move(read_func)),
+          batchSize(batch_size ? batch_size : 1), maxBatches(max_batches)
+    {}
+
+    ~TraceReadAhead() { stop(); }
+
+    TraceReadAhead(const TraceReadAhead &) = delete;
+    TraceReadAhead &operator=(const TraceReadAhead &) = delete;
+
+    /**
+     * Get the next element of the trace.
+     *
+     * @param elem Element to populate
+     * @return True if an element was read, false at the end of the trace
+     */
+    bool
+    read(T &elem)
+    {
+        if (maxBatches == 0)
+            return readFunc(elem);
+
+        if (next == current.size() && !nextBatch())
+            return false;
+
+        elem = std::move(current[next++]);
+        return true;
+    }
+
+    /**
+     * Stop decoding and discard the elements decoded so far. The rewind
+     * function is called once the background thread has stopped, so it
+     * can safely reset the underlying stream.
+     */
+    void
+    reset(const std::function<void()> &rewind)
+    {
+        stop();
+        rewind();
+    }
+
+  private:
+    /** Start the background thread */
+    void
+    start()
+    {
+        stopping = false;
+        done = false;
+        reader = std::thread(&TraceReadAhead::readBatches, this);
+    }
+
+    /** Stop the background thread and drop all the decoded elements */
+    void
+    stop()
+    {
+        if (reader.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            cond.notify_all();
+            reader.join();
+        }
+        batches.clear();
+        current.clear();
+        next = 0;
+    }
+
+    /** Wait for the next decoded batch, returns false at the end */
+    bool
+    nextBatch()
+    {
+        if (!reader.joinable())
+            start();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]{ return !batches.empty() || done; });
+        if (batches.empty())
+            return false;
+
+        current = std::move(batches.front());
+        batches.pop_front();
+        next = 0;
+
+        lock.unlock();
+        cond.notify_all();
+        return true;
+    }
+
+    /** Main loop of the background thread */
+    void
+    readBatches()
+    {
+        bool more = true;
+        while (more) {
+            std::vector<T> batch;
+            batch.reserve(batchSize);
+
+            T elem;
+            while (batch.size() < batchSize && (more = readFunc(elem)))
+                batch.push_back(std::move(elem));
+
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this]{
+                return batches.size() < maxBatches || stopping; });
+            if (stopping)
+                return;
+
+            if (!batch.empty())
+                batches.push_back(std::move(batch));
+            done = !more;
+
+            lock.unlock();
+            cond.notify_all();
+        }
+    }
+
+    /** Function decoding the next element of the trace */
+    const ReadFunc readFunc;
+
+    /** Number of elements in a batch */
+    const size_t batchSize;
+
+    /** Maximum number of batches decoded ahead */
+    const size_t maxBatches;
+
+    /** The batch the elements are currently taken from */
+    std::vector<T> current;
+
+    /** Index of the next element in the current batch */
+    size_t next = 0;
+
+    /** Decoded batches waiting to be consumed */
+    std::deque<std::vector<T>> batches;
+
+    /** Set by the background thread at the end of the trace */
+    bool done = false;
+
+    /** Set to ask the background thread to stop */
+    bool stopping = false;
+
+    /** Lock protecting the batch queue and the flags above */
+    std::mutex mutex;
+
+    /** Signals changes of the batch queue and the flags above */
+    std::condition_variable cond;
+
+    /** The background thread decoding the trace */
+    std::thread reader;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TRACE_TRACE_READ_AHEAD_HH__
@@ -33,7 +33,9 @@
  */
 #include "mem/page_table.hh"
 
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/trace.hh"
@@ -44,6 +46,80 @@
 namespace gem5
 {
 
+void
+EmulationPageTable::flushLookupCache()
+{
+    for (auto &slot : lookupCache)
+        slot.store(nullptr, std::memory_order_relaxed);
+}
+
+EmulationPageTable::PTableItr
+EmulationPageTable::findExtent(Addr vaddr)
+{
+    auto it = pTable.upper_bound(vaddr);
+    if (it == pTable.begin())
+        return pTable.end();
+    --it;
+    return vaddr - it->first < it->second.size ? it : pTable.end();
+}
+
+void
+EmulationPageTable::splitExtent(Addr vaddr)
+{
+    auto it = findExtent(vaddr);
+    if (it == pTable.end() || it->first == vaddr)
+        return;
+
+    Addr offset = vaddr - it->first;
+    Entry entry = it->second.entry;
+    pTable.emplace_hint(std::next(it), vaddr,
+            Extent(it->second.size - offset,
+                   Entry(entry.paddr + offset, entry.flags)));
+    it->second.size = offset;
+}
+
+void
+EmulationPageTable::insertExtent(Addr vaddr, const Extent &extent)
+{
+    auto mergeable = [](const PTable::value_type &a,
+                        const PTable::value_type &b) {
+        return a.first + a.second.size == b.first &&
+            a.second.entry.paddr + a.second.size == b.second.entry.paddr &&
+            a.second.entry.flags == b.second.entry.flags;
+    };
+
+    auto it = pTable.emplace(vaddr, extent).first;
+
+    auto next = std::next(it);
+    if (next != pTable.end() && mergeable(*it, *next)) {
+        it->second.size += next->second.size;
+        pTable.erase(next);
+    }
+
+    if (it != pTable.begin()) {
+        auto prev = std::prev(it);
+        if (mergeable(*prev, *it)) {
+            prev->second.size += it->second.size;
+            pTable.erase(it);
+        }
+    }
+}
+
+Addr
+EmulationPageTable::eraseExtents(Addr vaddr, Addr size)
+{
+    splitExtent(vaddr);
+    splitExtent(vaddr + size);
+
+    Addr erased = 0;
+    auto it = pTable.lower_bound(vaddr);
+    while (it != pTable.end() && it->first < vaddr + size) {
+        erased += it->second.size;
+        it = pTable.erase(it);
+    }
+    return erased;
+}
+
 void
 EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 {
@@ -53,22 +129,25 @@ EmulationPageTable::map(Addr vaddr, Addr paddr, int64_t size, uint64_t flags)
 
     DPRINTF(MMU, "Allocating Page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        if (it != pTable.end()) {
-            // already mapped
-            panic_if(!clobber,
-                     "EmulationPageTable::allocate: addr %#x already mapped",
-                     vaddr);
-            it->second = Entry(paddr, flags);
-        } else {
-            pTable.emplace(vaddr, Entry(paddr, flags));
-        }
-
-        size -= _pageSize;
-        vaddr += _pageSize;
-        paddr += _pageSize;
+    if (size <= 0)
+        return;
+    size = roundUp(size, _pageSize);
+
+    std::unique_lock<std::shared_mutex> lock(pTableMutex);
+    flushLookupCache();
+    if (clobber) {
+        eraseExtents(vaddr, size);
+    } else {
+        auto it = pTable.lower_bound(vaddr);
+        if (it == pTable.end() || it->first >= vaddr + size)
+            it = findExtent(vaddr);
+        // already mapped
+        panic_if(it != pTable.end(),
+                 "EmulationPageTable::allocate: addr %#x already mapped",
+                 std::max(vaddr, it->first));
     }
+
+    insertExtent(vaddr, Extent(size, Entry(paddr, flags)));
 }
 
 void
@@ -80,24 +159,42 @@ EmulationPageTable::remap(Addr vaddr, int64_t size, Addr new_vaddr)
     DPRINTF(MMU, "moving pages from vaddr %08p to %08p, size = %d\n", vaddr,
             new_vaddr, size);
 
-    while (size > 0) {
-        [[maybe_unused]] auto new_it = pTable.find(new_vaddr);
-        auto old_it = pTable.find(vaddr);
-        assert(old_it != pTable.end() && new_it == pTable.end());
+    if (size <= 0)
+        return;
+    size = roundUp(size, _pageSize);
+
+    std::unique_lock<std::shared_mutex> lock(pTableMutex);
+    flushLookupCache();
+    splitExtent(vaddr);
+    splitExtent(vaddr + size);
+
+    std::vector<PTable::value_type> moved;
+    auto it = pTable.lower_bound(vaddr);
+    while (it != pTable.end() && it->first < vaddr + size) {
+        moved.push_back(*it);
+        it = pTable.erase(it);
+    }
 
-        pTable.emplace(new_vaddr, old_it->second);
-        pTable.erase(old_it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-        new_vaddr += _pageSize;
+    [[maybe_unused]] Addr moved_size = 0;
+    for (auto &extent : moved) {
+        Addr new_start = extent.first - vaddr + new_vaddr;
+        assert(isUnmappedLocked(new_start, extent.second.size));
+        insertExtent(new_start, extent.second);
+        moved_size += extent.second.size;
     }
+    assert(moved_size == size);
 }
 
 void
 EmulationPageTable::getMappings(std::vector<std::pair<Addr, Addr>> *addr_maps)
 {
-    for (auto &iter : pTable)
-        addr_maps->push_back(std::make_pair(iter.first, iter.second.paddr));
+    std::shared_lock<std::shared_mutex> lock(pTableMutex);
+    for (auto &iter : pTable) {
+        for (Addr offset = 0; offset < iter.second.size; offset += _pageSize) {
+            addr_maps->push_back(std::make_pair(iter.first + offset,
+                        iter.second.entry.paddr + offset));
+        }
+    }
 }
 
 void
@@ -107,13 +204,23 @@ EmulationPageTable::unmap(Addr vaddr, int64_t size)
 
     DPRINTF(MMU, "Unmapping page: %#x-%#x\n", vaddr, vaddr + size);
 
-    while (size > 0) {
-        auto it = pTable.find(vaddr);
-        assert(it != pTable.end());
-        pTable.erase(it);
-        size -= _pageSize;
-        vaddr += _pageSize;
-    }
+    if (size <= 0)
+        return;
+    size = roundUp(size, _pageSize);
+
+    std::unique_lock<std::shared_mutex> lock(pTableMutex);
+    flushLookupCache();
+    [[maybe_unused]] Addr erased = eraseExtents(vaddr, size);
+    assert(erased == size);
+}
+
+bool
+EmulationPageTable::isUnmappedLocked(Addr vaddr, Addr size)
+{
+    auto it = pTable.lower_bound(vaddr);
+    if (it != pTable.end() && it->first < vaddr + size)
+        return false;
+    return findExtent(vaddr) == pTable.end();
 }
 
 bool
@@ -122,27 +229,37 @@ EmulationPageTable::isUnmapped(Addr vaddr, int64_t size)
     // starting address must be page aligned
     assert(pageOffset(vaddr) == 0);
 
-    for (int64_t offset = 0; offset < size; offset += _pageSize)
-        if (pTable.find(vaddr + offset) != pTable.end())
-            return false;
+    if (size <= 0)
+        return true;
 
-    return true;
+    std::shared_lock<std::shared_mutex> lock(pTableMutex);
+    return isUnmappedLocked(vaddr, size);
 }
 
-const EmulationPageTable::Entry *
+std::optional<EmulationPageTable::Entry>
 EmulationPageTable::lookup(Addr vaddr)
 {
     Addr page_addr = pageAlign(vaddr);
-    PTableItr iter = pTable.find(page_addr);
-    if (iter == pTable.end())
-        return nullptr;
-    return &(iter->second);
+    auto &slot = lookupCache[(vaddr >> LookupCacheShift) % LookupCacheSize];
+
+    std::shared_lock<std::shared_mutex> lock(pTableMutex);
+    const PTable::value_type *extent = slot.load(std::memory_order_relaxed);
+    if (!extent || page_addr - extent->first >= extent->second.size) {
+        auto it = findExtent(page_addr);
+        if (it == pTable.end())
+            return std::nullopt;
+        extent = &*it;
+        slot.store(extent, std::memory_order_relaxed);
+    }
+
+    const Entry &entry = extent->second.entry;
+    return Entry(entry.paddr + (page_addr - extent->first), entry.flags);
 }
 
 bool
 EmulationPageTable::translate(Addr vaddr, Addr &paddr)
 {
-    const Entry *entry = lookup(vaddr);
+    auto entry = lookup(vaddr);
     if (!entry) {
         DPRINTF(MMU, "Couldn't Translate: %#x\n", vaddr);
         return false;
@@ -185,18 +302,28 @@ EmulationPageTable::PageTableTranslationGen::translate(Range &range) const
 void
 EmulationPageTable::serialize(CheckpointOut &cp) const
 {
+    // Extents are stored as individual pages, which keeps checkpoints
+    // compatible with page tables that don't merge mappings.
+    PTable::size_type pages = 0;
+    for (auto &extent : pTable)
+        pages += extent.second.size / _pageSize;
+
     ScopedCheckpointSection sec(cp, "ptable");
-    paramOut(cp, "size", pTable.size());
+    paramOut(cp, "size", pages);
 
     PTable::size_type count = 0;
-    for (auto &pte : pTable) {
-        ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
-
-        paramOut(cp, "vaddr", pte.first);
-        paramOut(cp, "paddr", pte.second.paddr);
-        paramOut(cp, "flags", pte.second.flags);
+    for (auto &extent : pTable) {
+        const Entry &entry = extent.second.entry;
+        for (Addr offset = 0; offset < extent.second.size;
+                offset += _pageSize) {
+            ScopedCheckpointSection sec(cp, csprintf("Entry%d", count++));
+
+            paramOut(cp, "vaddr", extent.first + offset);
+            paramOut(cp, "paddr", entry.paddr + offset);
+            paramOut(cp, "flags", entry.flags);
+        }
     }
-    assert(count == pTable.size());
+    assert(count == pages);
 }
 
 void
@@ -206,6 +333,7 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
     ScopedCheckpointSection sec(cp, "ptable");
     paramIn(cp, "size", count);
 
+    flushLookupCache();
     for (int i = 0; i < count; ++i) {
         ScopedCheckpointSection sec(cp, csprintf("Entry%d", i));
 
@@ -216,7 +344,7 @@ EmulationPageTable::unserialize(CheckpointIn &cp)
         UNSERIALIZE_SCALAR(paddr);
         UNSERIALIZE_SCALAR(flags);
 
-        pTable.emplace(vaddr, Entry(paddr, flags));
+        insertExtent(vaddr, Extent(_pageSize, Entry(paddr, flags)));
     }
 }
 
@@ -224,8 +352,12 @@ const std::string
 EmulationPageTable::externalize() const
 {
     std::stringstream ss;
-    for (PTable::const_iterator it=pTable.begin(); it != pTable.end(); ++it) {
-        ss << std::hex << it->first << ":" << it->second.paddr << ";";
+    for (auto &extent : pTable) {
+        for (Addr offset = 0; offset < extent.second.size;
+                offset += _pageSize) {
+            ss << std::hex << extent.first + offset << ":"
+               << extent.second.entry.paddr + offset << ";";
+        }
     }
     return ss.str();
 }
@@ -35,8 +35,12 @@
 #ifndef __MEM_PAGE_TABLE_HH__
 #define __MEM_PAGE_TABLE_HH__
 
+#include <array>
+#include <atomic>
+#include <map>
+#include <optional>
+#include <shared_mutex>
 #include <string>
-#include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
@@ -63,10 +67,73 @@ class EmulationPageTable : public Serializable
     };
 
   protected:
-    typedef std::unordered_map<Addr, Entry> PTable;
+    /**
+     * A run of pages which are contiguous in both the virtual and the
+     * physical address space and share the same flags. Neighbouring
+     * mappings are merged into a single extent, so a process with a large
+     * footprint needs a handful of extents instead of one entry per page.
+     * Extents are split again if part of them is unmapped or remapped.
+     */
+    struct Extent
+    {
+        Addr size;
+        // Physical address and flags of the first page in the extent.
+        Entry entry;
+
+        Extent(Addr size, const Entry &entry) : size(size), entry(entry) {}
+    };
+
+    // Extents indexed by their starting virtual address.
+    typedef std::map<Addr, Extent> PTable;
     typedef PTable::iterator PTableItr;
     PTable pTable;
 
+    /**
+     * Lock protecting pTable. Threads sharing an address space may be
+     * simulated in different event queues, so mappings can change while
+     * other threads translate addresses.
+     */
+    mutable std::shared_mutex pTableMutex;
+
+    /**
+     * A small direct-mapped cache of recently used extents, indexed by the
+     * 2 MiB region of the looked up address. Lookups fill it while only
+     * holding a shared lock, so the slots are atomic. The cache is flushed
+     * whenever pTable changes, which requires the exclusive lock, so the
+     * cached extents can't be erased while they are being used.
+     */
+    static constexpr int LookupCacheShift = 21;
+    static constexpr int LookupCacheSize = 64;
+    mutable std::array<std::atomic<const PTable::value_type *>,
+                       LookupCacheSize> lookupCache;
+
+    void flushLookupCache();
+
+    /**
+     * Find the extent containing vaddr. The caller must hold pTableMutex.
+     * @return The extent, or pTable.end() if vaddr isn't mapped.
+     */
+    PTableItr findExtent(Addr vaddr);
+
+    /**
+     * Split the extent containing vaddr, if any, so that one of the
+     * resulting extents starts at vaddr.
+     */
+    void splitExtent(Addr vaddr);
+
+    /**
+     * Add an extent and merge it with its neighbours where possible.
+     */
+    void insertExtent(Addr vaddr, const Extent &extent);
+
+    /**
+     * Remove all mappings from a page aligned region.
+     * @return The number of bytes which were mapped in the region.
+     */
+    Addr eraseExtents(Addr vaddr, Addr size);
+
+    bool isUnmappedLocked(Addr vaddr, Addr size);
+
     const Addr _pageSize;
     const Addr offsetMask;
 
@@ -81,6 +148,7 @@ class EmulationPageTable : public Serializable
             _pid(_pid), _name(__name), shared(false)
     {
         assert(isPowerOf2(_pageSize));
+        flushLookupCache();
     }
 
     uint64_t pid() const { return _pid; };
@@ -137,9 +205,10 @@ class EmulationPageTable : public Serializable
     /**
      * Lookup function
      * @param vaddr The virtual address.
-     * @return The page table entry corresponding to vaddr.
+     * @return The page table entry of the page containing vaddr, if it is
+     *         mapped.
      */
-    const Entry *lookup(Addr vaddr);
+    std::optional<Entry> lookup(Addr vaddr);
 
     /**
      * Translate function
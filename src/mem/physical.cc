@@ -275,6 +275,16 @@ PhysicalMemory::isMemAddr(Addr addr) const
     return addrMap.contains(addr) != addrMap.end();
 }
 
+uint8_t *
+PhysicalMemory::hostAddr(Addr addr, Addr size) const
+{
+    auto m = addrMap.contains(RangeSize(addr, size));
+    if (m == addrMap.end() || m->second->isNull())
+        return nullptr;
+
+    return m->second->toHostAddr(addr);
+}
+
 AddrRangeList
 PhysicalMemory::getConfAddrRanges() const
 {
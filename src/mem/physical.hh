@@ -213,6 +213,19 @@ class PhysicalMemory : public Serializable
      */
     bool isMemAddr(Addr addr) const;
 
+    /**
+     * Get a host pointer to a range of physical memory. This bypasses
+     * the memory system, including any caches, and is intended for
+     * emulation code that needs bulk access to guest memory.
+     *
+     * @param addr Start of the physical address range
+     * @param size Size of the range
+     * @return Pointer to the backing store of the range, or nullptr
+     *         if the range isn't backed by a single memory in the
+     *         global address map
+     */
+    uint8_t *hostAddr(Addr addr, Addr size) const;
+
     /**
      * Get the memory ranges for all memories that are to be reported
      * to the configuration table. The ranges are merged before they
@@ -30,6 +30,8 @@
 #include "mem/ruby/network/Topology.hh"
 
 #include <cassert>
+#include <functional>
+#include <queue>
 
 #include "base/trace.hh"
 #include "debug/RubyNetwork.hh"
@@ -123,17 +125,11 @@ Topology::createLinks(Network *net)
         max_switch_id = std::max(max_switch_id, src_dest.second);
     }
 
-    // Initialize weight, latency, and inter switched vectors
+    // Initialize weight vectors
     int num_switches = max_switch_id+1;
     Matrix topology_weights(m_vnets,
             std::vector<std::vector<int>>(num_switches,
             std::vector<int>(num_switches, INFINITE_LATENCY)));
-    Matrix component_latencies(num_switches,
-            std::vector<std::vector<int>>(num_switches,
-            std::vector<int>(m_vnets, -1)));
-    Matrix component_inter_switches(num_switches,
-            std::vector<std::vector<int>>(num_switches,
-            std::vector<int>(m_vnets, 0)));
 
     // Set identity weights to zero
     for (int i = 0; i < topology_weights[0].size(); i++) {
@@ -142,7 +138,7 @@ Topology::createLinks(Network *net)
         }
     }
 
-    // Fill in the topology weights and bandwidth multipliers
+    // Fill in the topology weights
     for (auto link_group : m_link_map) {
         std::pair<int, int> src_dest = link_group.first;
         std::vector<bool> vnet_done(m_vnets, 0);
@@ -160,7 +156,6 @@ Topology::createLinks(Network *net)
                     fatal_if(vnet_done[v], "Two links connecting same src"
                     " and destination cannot support same vnets");
 
-                    component_latencies[src][dst][v] = link->m_latency;
                     topology_weights[v][src][dst] = link->m_weight;
                     vnet_done[v] = true;
                 }
@@ -174,7 +169,6 @@ Topology::createLinks(Network *net)
                     fatal_if(vnet_done[vnet], "Two links connecting same src"
                     " and destination cannot support same vnets");
 
-                    component_latencies[src][dst][vnet] = link->m_latency;
                     topology_weights[vnet][src][dst] = link->m_weight;
                     vnet_done[vnet] = true;
                 }
@@ -183,8 +177,7 @@ Topology::createLinks(Network *net)
     }
 
     // Walk topology and hookup the links
-    Matrix dist = shortest_path(topology_weights, component_latencies,
-                                component_inter_switches);
+    Matrix dist = shortest_path(topology_weights);
 
     for (int i = 0; i < topology_weights[0].size(); i++) {
         for (int j = 0; j < topology_weights[0][i].size(); j++) {
@@ -330,72 +323,56 @@ Topology::makeLink(Network *net, SwitchID src, SwitchID dest,
     }
 }
 
-// The following all-pairs shortest path algorithm is based on the
-// discussion from Cormen et al., Chapter 26.1.
-void
-Topology::extend_shortest_path(Matrix &current_dist, Matrix &latencies,
-    Matrix &inter_switches)
+// All-pairs shortest paths, computed with one run of Dijkstra's algorithm
+// per source over the sparse link graph rather than by relaxing the dense
+// weight matrix. As before, switches that are unreachable, or further
+// apart than INFINITE_LATENCY, are INFINITE_LATENCY apart.
+Matrix
+Topology::shortest_path(const Matrix &weights)
 {
-    int nodes = current_dist[0].size();
+    const SwitchID nodes = weights[0].size();
+    Matrix dist(m_vnets, std::vector<std::vector<int>>(nodes,
+                std::vector<int>(nodes, INFINITE_LATENCY)));
+
+    typedef std::pair<int, SwitchID> QueueEntry;
 
-    // We find the shortest path for each vnet for a given pair of
-    // source and destinations. This is done simply by traversing via
-    // all other nodes and finding the minimum distance.
     for (int v = 0; v < m_vnets; v++) {
-        // There is a different topology for each vnet. Here we try to
-        // build a topology by finding the minimum number of intermediate
-        // switches needed to reach the destination
-        bool change = true;
-        while (change) {
-            change = false;
-            for (int i = 0; i < nodes; i++) {
-                for (int j = 0; j < nodes; j++) {
-                    // We follow an iterative process to build the shortest
-                    // path tree:
-                    // 1. Start from the direct connection (if there is one,
-                    // otherwise assume a hypothetical infinite weight link).
-                    // 2. Then we iterate through all other nodes considering
-                    // new potential intermediate switches. If we find any
-                    // lesser weight combination, we set(update) that as the
-                    // new weight between the source and destination.
-                    // 3. Repeat for all pairs of nodes.
-                    // 4. Go to step 1 if there was any new update done in
-                    // Step 2.
-                    int minimum = current_dist[v][i][j];
-                    int previous_minimum = minimum;
-                    int intermediate_switch = -1;
-                    for (int k = 0; k < nodes; k++) {
-                        minimum = std::min(minimum,
-                            current_dist[v][i][k] + current_dist[v][k][j]);
-                        if (previous_minimum != minimum) {
-                            intermediate_switch = k;
-                            inter_switches[i][j][v] =
-                                inter_switches[i][k][v] +
-                                inter_switches[k][j][v] + 1;
-                        }
-                        previous_minimum = minimum;
-                    }
-                    if (current_dist[v][i][j] != minimum) {
-                        change = true;
-                        current_dist[v][i][j] = minimum;
-                        assert(intermediate_switch >= 0);
-                        assert(intermediate_switch < latencies[i].size());
-                        latencies[i][j][v] =
-                            latencies[i][intermediate_switch][v] +
-                            latencies[intermediate_switch][j][v];
+        // Each vnet has its own topology, made of the links carrying it
+        std::vector<std::vector<std::pair<SwitchID, int>>> adjacent(nodes);
+        for (const auto &link_group : m_link_map) {
+            SwitchID src = link_group.first.first;
+            SwitchID dst = link_group.first.second;
+            int weight = weights[v][src][dst];
+            if (weight != INFINITE_LATENCY) {
+                adjacent[src].emplace_back(dst, weight);
+            }
+        }
+
+        for (SwitchID src = 0; src < nodes; src++) {
+            std::vector<int> &src_dist = dist[v][src];
+            std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                                std::greater<QueueEntry>> queue;
+
+            src_dist[src] = 0;
+            queue.emplace(0, src);
+            while (!queue.empty()) {
+                auto [cur_dist, cur] = queue.top();
+                queue.pop();
+                if (cur_dist > src_dist[cur]) {
+                    // Stale entry, a shorter path was found since
+                    continue;
+                }
+                for (const auto &[next, weight] : adjacent[cur]) {
+                    int next_dist = cur_dist + weight;
+                    if (next_dist < src_dist[next]) {
+                        src_dist[next] = next_dist;
+                        queue.emplace(next_dist, next);
                     }
                 }
             }
         }
     }
-}
 
-Matrix
-Topology::shortest_path(const Matrix &weights, Matrix &latencies,
-                        Matrix &inter_switches)
-{
-    Matrix dist = weights;
-    extend_shortest_path(dist, latencies, inter_switches);
     return dist;
 }
 
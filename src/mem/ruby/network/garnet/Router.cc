@@ -159,7 +159,8 @@ Router::getInportDirection(int inport)
 }
 
 int
-Router::route_compute(RouteInfo route, int inport, PortDirection inport_dirn)
+Router::route_compute(const RouteInfo &route, int inport,
+                      PortDirection inport_dirn)
 {
     return routingUnit.outportCompute(route, inport, inport_dirn);
 }
@@ -94,7 +94,7 @@ RoutingUnit::supportsVnet(int vnet, std::vector<int> sVnets)
  * Correct weight assignments are critical to provide deadlock avoidance.
  */
 int
-RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
+RoutingUnit::lookupRoutingTable(int vnet, const NetDest &msg_destination)
 {
     // First find all possible output link candidates
     // For ordered vnet, just choose the first
@@ -108,21 +108,18 @@ RoutingUnit::lookupRoutingTable(int vnet, NetDest msg_destination)
     std::vector<int> output_link_candidates;
     int num_candidates = 0;
 
-    // Identify the minimum weight among the candidate output links
-    for (int link = 0; link < m_routing_table[vnet].size(); link++) {
-        if (msg_destination.intersectionIsNotEmpty(
-            m_routing_table[vnet][link])) {
-
-        if (m_weight_table[link] <= min_weight)
-            min_weight = m_weight_table[link];
-        }
-    }
-
-    // Collect all candidate output links with this minimum weight
+    // Collect all candidate output links with the minimum weight in a
+    // single pass, restarting the collection whenever a lower weight shows
+    // up.
     for (int link = 0; link < m_routing_table[vnet].size(); link++) {
         if (msg_destination.intersectionIsNotEmpty(
             m_routing_table[vnet][link])) {
 
+            if (m_weight_table[link] < min_weight) {
+                min_weight = m_weight_table[link];
+                num_candidates = 0;
+                output_link_candidates.clear();
+            }
             if (m_weight_table[link] == min_weight) {
                 num_candidates++;
                 output_link_candidates.push_back(link);
@@ -166,7 +163,7 @@ RoutingUnit::addOutDirection(PortDirection outport_dirn, int outport_idx)
 // table is provided here.
 
 int
-RoutingUnit::outportCompute(RouteInfo route, int inport,
+RoutingUnit::outportCompute(const RouteInfo &route, int inport,
                             PortDirection inport_dirn)
 {
     int outport = -1;
@@ -205,7 +202,7 @@ RoutingUnit::outportCompute(RouteInfo route, int inport,
 // Only for reference purpose in a Mesh
 // By default Garnet uses the routing table
 int
-RoutingUnit::outportComputeXY(RouteInfo route,
+RoutingUnit::outportComputeXY(const RouteInfo &route,
                               int inport,
                               PortDirection inport_dirn)
 {
@@ -263,7 +260,7 @@ RoutingUnit::outportComputeXY(RouteInfo route,
 // Template for implementing custom routing algorithm
 // using port directions. (Example adaptive)
 int
-RoutingUnit::outportComputeCustom(RouteInfo route,
+RoutingUnit::outportComputeCustom(const RouteInfo &route,
                                  int inport,
                                  PortDirection inport_dirn)
 {
@@ -139,6 +139,20 @@ class AbstractController : public ClockedObject, public Consumer
     virtual int functionalWrite(const Addr &addr, PacketPtr) = 0;
     int functionalMemoryWrite(PacketPtr);
 
+    //! Functional cache warmup. Installs the block at addr in a stable
+    //! state as if requestor had just completed a request of the given
+    //! type, without sending messages or scheduling events. The requestor
+    //! is called first and returns whether it could hold the block; only
+    //! then are the other controllers called so that directories and
+    //! shared levels can track it. Protocols opt in by defining
+    //! functionalWarmup() in their state machines.
+    virtual bool hasFunctionalWarmup() const { return false; }
+    virtual bool functionalWarmup(const Addr &addr,
+                                  const RubyRequestType &type,
+                                  const MachineID &requestor,
+                                  const DataBlock &data)
+    { panic("functionalWarmup() not implemented"); }
+
     //! Function for enqueuing a prefetch request
     virtual void enqueuePrefetch(const Addr &, const RubyRequestType&)
     { fatal("Prefetches not implemented!");}
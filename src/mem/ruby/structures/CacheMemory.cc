@@ -99,6 +99,7 @@ CacheMemory::init()
 
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    m_tags.assign((size_t)m_cache_num_sets * m_cache_assoc, MaxAddr);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -135,13 +136,10 @@ CacheMemory::addressToCacheSet(Addr address) const
 int
 CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
-    assert(tag == makeLineAddress(tag));
-    // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    int loc = findTagInSetIgnorePermissions(cacheSet, tag);
+    if (loc != -1 &&
+        m_cache[cacheSet][loc]->m_Permission != AccessPermission_NotPresent)
+        return loc;
     return -1; // Not found
 }
 
@@ -153,9 +151,11 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
+    const Addr *set_tags = &m_tags[cacheSet * m_cache_assoc];
+    for (int i = 0; i < m_cache_assoc; i++) {
+        if (set_tags[i] == tag)
+            return i;
+    }
     return -1; // Not found
 }
 
@@ -291,7 +291,7 @@ CacheMemory::allocate(Addr address, AbstractCacheEntry *entry)
             DPRINTF(RubyCache, "Allocate clearing lock for addr: %x\n",
                     address);
             set[i]->m_locked = -1;
-            m_tag_index[address] = i;
+            m_tags[cacheSet * m_cache_assoc + i] = address;
             set[i]->setPosition(cacheSet, i);
             set[i]->replacementData = replacement_data[cacheSet][i];
             set[i]->setLastAccess(curTick());
@@ -317,7 +317,7 @@ CacheMemory::deallocate(Addr address)
     uint32_t way = entry->getWay();
     delete entry;
     m_cache[cache_set][way] = NULL;
-    m_tag_index.erase(address);
+    m_tags[cache_set * m_cache_assoc + way] = MaxAddr;
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -43,7 +43,6 @@
 #define __MEM_RUBY_STRUCTURES_CACHEMEMORY_HH__
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "base/statistics.hh"
@@ -178,9 +177,17 @@ class CacheMemory : public SimObject
 
     // The first index is the # of cache lines.
     // The second index is the the amount associativity.
-    std::unordered_map<Addr, int> m_tag_index;
     std::vector<std::vector<AbstractCacheEntry*> > m_cache;
 
+    /**
+     * Line addresses of the resident blocks, laid out contiguously by set
+     * (set * assoc + way) so that a lookup only scans the ways of a single
+     * set. Unused ways hold MaxAddr, which never matches a line address.
+     * This mirrors m_cache and replaces a global address-to-way hash map,
+     * whose per-line nodes dominated host memory for large caches.
+     */
+    std::vector<Addr> m_tags;
+
     /** We use the replacement policies from the Classic memory system. */
     replacement_policy::Base *m_replacementPolicy_ptr;
 
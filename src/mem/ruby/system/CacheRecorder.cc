@@ -29,7 +29,10 @@
 
 #include "mem/ruby/system/CacheRecorder.hh"
 
+#include <set>
+
 #include "debug/RubyCacheTrace.hh"
+#include "mem/ruby/slicc_interface/AbstractController.hh"
 #include "mem/ruby/system/RubySystem.hh"
 #include "mem/ruby/system/Sequencer.hh"
 
@@ -105,53 +108,164 @@ CacheRecorder::enqueueNextFlushRequest()
     }
 }
 
+void
+CacheRecorder::issueFetchRequest(TraceRecord *traceRecord)
+{
+    DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
+
+    for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
+            rec_bytes_read += RubySystem::getBlockSizeBytes()) {
+        RequestPtr req;
+        MemCmd::Command requestType;
+
+        if (traceRecord->m_type == RubyRequestType_LD) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                                Request::funcRequestorId);
+        }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
+            requestType = MemCmd::ReadReq;
+            req = std::make_shared<Request>(
+                    traceRecord->m_data_address + rec_bytes_read,
+                    RubySystem::getBlockSizeBytes(),
+                    Request::INST_FETCH, Request::funcRequestorId);
+        }   else {
+            requestType = MemCmd::WriteReq;
+            req = std::make_shared<Request>(
+                traceRecord->m_data_address + rec_bytes_read,
+                RubySystem::getBlockSizeBytes(), 0,
+                            Request::funcRequestorId);
+        }
+
+        Packet *pkt = new Packet(req, requestType);
+        pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
+
+        Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
+        assert(m_sequencer_ptr != NULL);
+        m_sequencer_ptr->makeRequest(pkt);
+    }
+
+    m_records_read++;
+}
+
 void
 CacheRecorder::enqueueNextFetchRequest()
 {
     if (m_bytes_read < m_uncompressed_trace_size) {
         TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
                                                                 m_bytes_read);
+        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
+        issueFetchRequest(traceRecord);
+    } else {
+        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
+    }
+}
+
+void
+CacheRecorder::enqueueParallelFetchRequests()
+{
+    // Split the trace by the sequencer replaying each record, keeping
+    // the recorded order within each sequencer.
+    while (m_bytes_read < m_uncompressed_trace_size) {
+        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
+                                                                m_bytes_read);
+        m_fetch_queues[m_seq_map[traceRecord->m_cntrl_id]].push_back(
+            traceRecord);
+        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
+    }
+
+    DPRINTF(RubyCacheTrace, "Replaying the trace through %d sequencers\n",
+            m_fetch_queues.size());
+
+    // Start the sequencers in controller order, so that the replay does
+    // not depend on where the sequencers happen to be allocated.
+    std::set<Sequencer*> started;
+    for (auto seq : m_seq_map) {
+        if (m_fetch_queues.count(seq) && started.insert(seq).second) {
+            enqueueNextFetchRequest(seq);
+        }
+    }
+}
+
+void
+CacheRecorder::enqueueNextFetchRequest(Sequencer *seq)
+{
+    if (m_fetch_queues.empty()) {
+        enqueueNextFetchRequest();
+        return;
+    }
+
+    auto queue = m_fetch_queues.find(seq);
+    assert(queue != m_fetch_queues.end());
+    if (!queue->second.empty()) {
+        TraceRecord* traceRecord = queue->second.front();
+        queue->second.pop_front();
+        issueFetchRequest(traceRecord);
+    } else {
+        DPRINTF(RubyCacheTrace, "%s fetched all its records\n",
+                seq->name());
+    }
+}
+
+bool
+CacheRecorder::functionalWarmup(
+    const std::vector<AbstractController*> &cntrls)
+{
+    const uint64_t record_size = sizeof(TraceRecord) + m_block_size_bytes;
+
+    // Make sure every record can be replayed before touching any state, so
+    // that the caller can still fall back to the timing replay.
+    for (uint64_t offset = m_bytes_read; offset < m_uncompressed_trace_size;
+         offset += record_size) {
+        TraceRecord* traceRecord =
+            (TraceRecord*) (m_uncompressed_trace + offset);
+        if (!cntrls[traceRecord->m_cntrl_id]->hasFunctionalWarmup()) {
+            DPRINTF(RubyCacheTrace, "%s cannot be warmed up functionally\n",
+                    cntrls[traceRecord->m_cntrl_id]->name());
+            return false;
+        }
+    }
+
+    std::vector<AbstractController*> observers;
+    for (auto cntrl : cntrls) {
+        if (cntrl->hasFunctionalWarmup())
+            observers.push_back(cntrl);
+    }
+
+    DataBlock data;
+    while (m_bytes_read < m_uncompressed_trace_size) {
+        TraceRecord* traceRecord = (TraceRecord*) (m_uncompressed_trace +
+                                                                m_bytes_read);
+        AbstractController *requestor = cntrls[traceRecord->m_cntrl_id];
+        const MachineID machine = requestor->getMachineID();
 
-        DPRINTF(RubyCacheTrace, "Issuing %s\n", *traceRecord);
+        DPRINTF(RubyCacheTrace, "Installing %s\n", *traceRecord);
 
         for (int rec_bytes_read = 0; rec_bytes_read < m_block_size_bytes;
                 rec_bytes_read += RubySystem::getBlockSizeBytes()) {
-            RequestPtr req;
-            MemCmd::Command requestType;
+            Addr addr = traceRecord->m_data_address + rec_bytes_read;
+            data.setData(traceRecord->m_data + rec_bytes_read, 0,
+                         RubySystem::getBlockSizeBytes());
 
-            if (traceRecord->m_type == RubyRequestType_LD) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                    Request::funcRequestorId);
-            }   else if (traceRecord->m_type == RubyRequestType_IFETCH) {
-                requestType = MemCmd::ReadReq;
-                req = std::make_shared<Request>(
-                        traceRecord->m_data_address + rec_bytes_read,
-                        RubySystem::getBlockSizeBytes(),
-                        Request::INST_FETCH, Request::funcRequestorId);
-            }   else {
-                requestType = MemCmd::WriteReq;
-                req = std::make_shared<Request>(
-                    traceRecord->m_data_address + rec_bytes_read,
-                    RubySystem::getBlockSizeBytes(), 0,
-                                Request::funcRequestorId);
+            if (!requestor->functionalWarmup(addr, traceRecord->m_type,
+                                             machine, data)) {
+                continue;
+            }
+            for (auto cntrl : observers) {
+                if (cntrl != requestor) {
+                    cntrl->functionalWarmup(addr, traceRecord->m_type,
+                                            machine, data);
+                }
             }
-
-            Packet *pkt = new Packet(req, requestType);
-            pkt->dataStatic(traceRecord->m_data + rec_bytes_read);
-
-            Sequencer* m_sequencer_ptr = m_seq_map[traceRecord->m_cntrl_id];
-            assert(m_sequencer_ptr != NULL);
-            m_sequencer_ptr->makeRequest(pkt);
         }
 
-        m_bytes_read += (sizeof(TraceRecord) + m_block_size_bytes);
+        m_bytes_read += record_size;
         m_records_read++;
-    } else {
-        DPRINTF(RubyCacheTrace, "Fetched all %d records\n", m_records_read);
     }
+
+    DPRINTF(RubyCacheTrace, "Installed all %d records\n", m_records_read);
+    return true;
 }
 
 void
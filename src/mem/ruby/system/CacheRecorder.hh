@@ -35,6 +35,8 @@
 #ifndef __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 #define __MEM_RUBY_SYSTEM_CACHERECORDER_HH__
 
+#include <deque>
+#include <map>
 #include <vector>
 
 #include "base/types.hh"
@@ -49,6 +51,7 @@ namespace gem5
 namespace ruby
 {
 
+class AbstractController;
 class Sequencer;
 
 /*!
@@ -106,15 +109,43 @@ class CacheRecorder
      */
     void enqueueNextFetchRequest();
 
+    /*!
+     * Function for warming up the caches with one outstanding fetch per
+     * sequencer instead of one for the whole system. The trace is split
+     * by the sequencer replaying each record, and every sequencer moves
+     * on to its next record as soon as its previous one completes.
+     */
+    void enqueueParallelFetchRequests();
+
+    /*!
+     * Called by a sequencer once one of its warmup fetches completed.
+     * Issues the next record of that sequencer when replaying in
+     * parallel, or the next record of the trace otherwise.
+     */
+    void enqueueNextFetchRequest(Sequencer *seq);
+
+    /*!
+     * Function for warming up the caches without simulating. Each record
+     * is installed directly in the controller that recorded it and then
+     * announced to the remaining controllers through
+     * AbstractController::functionalWarmup(). Returns false, without
+     * changing any state, if one of the recording controllers does not
+     * support functional warmup.
+     */
+    bool functionalWarmup(const std::vector<AbstractController*> &cntrls);
+
   private:
     // Private copy constructor and assignment operator
     CacheRecorder(const CacheRecorder& obj);
     CacheRecorder& operator=(const CacheRecorder& obj);
 
+    void issueFetchRequest(TraceRecord *traceRecord);
+
     std::vector<TraceRecord*> m_records;
     uint8_t* m_uncompressed_trace;
     uint64_t m_uncompressed_trace_size;
     std::vector<Sequencer*> m_seq_map;
+    std::map<Sequencer*, std::deque<TraceRecord*>> m_fetch_queues;
     uint64_t m_bytes_read;
     uint64_t m_records_read;
     uint64_t m_records_flushed;
@@ -43,6 +43,7 @@
 #include <fcntl.h>
 #include <zlib.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <list>
 
@@ -76,8 +77,13 @@ bool RubySystem::m_warmup_enabled = false;
 unsigned RubySystem::m_systems_to_warmup = 0;
 bool RubySystem::m_cooldown_enabled = false;
 
+// Largest piece of a cache trace handed to zlib in a single call
+static const uint64_t traceChunkSize = 1ULL << 30;
+
 RubySystem::RubySystem(const Params &p)
     : ClockedObject(p), m_access_backing_store(p.access_backing_store),
+      m_functional_warmup(p.functional_warmup),
+      m_parallel_warmup(p.parallel_warmup),
       m_cache_recorder(NULL)
 {
     m_randomization = p.randomization;
@@ -303,9 +309,14 @@ RubySystem::writeCompressedTrace(uint8_t *raw_data, std::string filename,
         fatal("Insufficient memory to allocate compression state for %s\n",
               filename);
 
-    if (gzwrite(compressedMemory, raw_data, uncompressed_trace_size) !=
-        uncompressed_trace_size) {
-        fatal("Write failed on memory trace file '%s'\n", filename);
+    // zlib takes the length as an unsigned int, so write large traces
+    // in chunks rather than truncating them.
+    for (uint64_t offset = 0; offset < uncompressed_trace_size;
+         offset += traceChunkSize) {
+        int len = std::min(traceChunkSize, uncompressed_trace_size - offset);
+        if (gzwrite(compressedMemory, raw_data + offset, len) != len) {
+            fatal("Write failed on memory trace file '%s'\n", filename);
+        }
     }
 
     if (gzclose(compressedMemory)) {
@@ -374,9 +385,12 @@ RubySystem::readCompressedTrace(std::string filename, uint8_t *&raw_data,
     }
 
     raw_data = new uint8_t[uncompressed_trace_size];
-    if (gzread(compressedTrace, raw_data, uncompressed_trace_size) <
-            uncompressed_trace_size) {
-        fatal("Unable to read complete trace from file %s\n", filename);
+    for (uint64_t offset = 0; offset < uncompressed_trace_size;
+         offset += traceChunkSize) {
+        int len = std::min(traceChunkSize, uncompressed_trace_size - offset);
+        if (gzread(compressedTrace, raw_data + offset, len) < len) {
+            fatal("Unable to read complete trace from file %s\n", filename);
+        }
     }
 
     if (gzclose(compressedTrace)) {
@@ -438,18 +452,39 @@ RubySystem::startup()
     // state was checkpointed.
 
     if (m_warmup_enabled) {
-        DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
-        // save the current tick value
-        Tick curtick_original = curTick();
-        // save the event queue head
-        Event* eventq_head = eventq->replaceHead(NULL);
-        // set curTick to 0 and reset Ruby System's clock
-        setCurTick(0);
-        resetClock();
-
-        // Schedule an event to start cache warmup
-        enqueueRubyEvent(curTick());
-        simulate();
+        // If the protocol supports it, install the recorded blocks directly
+        // in the controllers. This needs neither the clock reset nor any
+        // simulated time.
+        bool warmed_up = false;
+        if (m_functional_warmup) {
+            DPRINTF(RubyCacheTrace, "Starting ruby functional warmup\n");
+            warmed_up = m_cache_recorder->functionalWarmup(m_abs_cntrl_vec);
+            if (!warmed_up) {
+                warn("Protocol does not support functional cache warmup, "
+                     "replaying the cache trace in timing mode.\n");
+            }
+        }
+
+        if (!warmed_up) {
+            DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
+            // save the current tick value
+            Tick curtick_original = curTick();
+            // save the event queue head
+            Event* eventq_head = eventq->replaceHead(NULL);
+            // set curTick to 0 and reset Ruby System's clock
+            setCurTick(0);
+            resetClock();
+
+            // Schedule an event to start cache warmup
+            enqueueRubyEvent(curTick());
+            simulate();
+
+            // Restore eventq head
+            eventq->replaceHead(eventq_head);
+            // Restore curTick and Ruby System's clock
+            setCurTick(curtick_original);
+            resetClock();
+        }
 
         delete m_cache_recorder;
         m_cache_recorder = NULL;
@@ -457,12 +492,6 @@ RubySystem::startup()
         if (m_systems_to_warmup == 0) {
             m_warmup_enabled = false;
         }
-
-        // Restore eventq head
-        eventq->replaceHead(eventq_head);
-        // Restore curTick and Ruby System's clock
-        setCurTick(curtick_original);
-        resetClock();
     }
 
     resetStats();
@@ -472,7 +501,11 @@ void
 RubySystem::processRubyEvent()
 {
     if (getWarmupEnabled()) {
-        m_cache_recorder->enqueueNextFetchRequest();
+        if (m_parallel_warmup) {
+            m_cache_recorder->enqueueParallelFetchRequests();
+        } else {
+            m_cache_recorder->enqueueNextFetchRequest();
+        }
     } else if (getCooldownEnabled()) {
         m_cache_recorder->enqueueNextFlushRequest();
     }
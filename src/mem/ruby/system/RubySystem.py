@@ -57,6 +57,19 @@ class RubySystem(ClockedObject):
         store and only use ruby for timing.",
     )
 
+    functional_warmup = Param.Bool(
+        False,
+        "Restore the cache contents of a checkpoint by installing them \
+        directly in the controllers instead of replaying them through the \
+        timing protocol. Falls back to the timing replay if the protocol \
+        does not support it.",
+    )
+    parallel_warmup = Param.Bool(
+        False,
+        "Replay the cache trace of a checkpoint with one outstanding \
+        request per sequencer instead of one for the whole system.",
+    )
+
     # Profiler related configuration variables
     hot_lines = Param.Bool(False, "")
     all_instructions = Param.Bool(False, "")
@@ -91,6 +91,12 @@ def main(args=None):
         action="store_true",
         help="print traceback on error",
     )
+    parser.add_option(
+        "--fast-transitions",
+        action="store_true",
+        help="dispatch transitions through a dense table and inline "
+        "short actions",
+    )
     parser.add_option("-q", "--quiet", help="don't print messages")
     opts, files = parser.parse_args(args=args)
 
@@ -118,6 +124,7 @@ def main(args=None):
         verbose=True,
         debug=opts.debug,
         traceback=opts.tb,
+        fast_transitions=opts.fast_transitions,
     )
 
     if opts.print_files:
@@ -51,11 +51,18 @@ from slicc.symbols import SymbolTable
 
 class SLICC(Grammar):
     def __init__(
-        self, filename, base_dir, verbose=False, traceback=False, **kwargs
+        self,
+        filename,
+        base_dir,
+        verbose=False,
+        traceback=False,
+        fast_transitions=False,
+        **kwargs,
     ):
         self.protocol = None
         self.traceback = traceback
         self.verbose = verbose
+        self.fast_transitions = fast_transitions
         self.symtab = SymbolTable(self)
         self.base_dir = base_dir
 
@@ -125,6 +125,8 @@ class StateMachine(Symbol):
         self.debug_flags = set()
         self.debug_flags.add("RubyGenerated")
         self.debug_flags.add("RubySlicc")
+        # Needed to only build transition comments while tracing
+        self.debug_flags.add("ProtocolTrace")
 
     def __repr__(self):
         return f"[StateMachine: {self.ident}]"
@@ -242,11 +244,91 @@ class StateMachine(Symbol):
                 in_msg_bufs[buf_name].append(port)
         return port_to_buf_map, in_msg_bufs, msg_bufs
 
+    def actionParams(self):
+        params = []
+        if self.TBEType != None:
+            params.append(f"{self.TBEType.c_ident}*& m_tbe_ptr")
+        if self.EntryType != None:
+            params.append(f"{self.EntryType.c_ident}*& m_cache_entry_ptr")
+        params.append("Addr addr")
+        return ", ".join(params)
+
+    def isInlineAction(self, action):
+        """Actions are normally defined in the controller source file. When
+        the fast_transitions option is set, short actions which don't peek
+        at a message are instead defined inline next to the transition
+        switch, so the compiler can inline them into the transitions that
+        call them."""
+        if not self.symtab.slicc.fast_transitions or "c_code" not in action:
+            return False
+        c_code = action["c_code"]
+        if "RejectException" in c_code:
+            return False
+        lines = [line for line in c_code.splitlines() if line.strip()]
+        return len(lines) <= 3
+
+    def printAction(self, code, action, inline=False):
+        ident = self.ident
+        c_ident = f"{self.ident}_Controller"
+        # Inline actions never peek, so they don't need to catch the
+        # exception a peek at the wrong message type throws.
+        if self.TBEType != None and self.EntryType != None and not inline:
+            code(
+                """
+/** \\brief ${{action.desc}} */
+void
+$c_ident::${{action.ident}}(${{self.actionParams()}})
+{
+    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
+    try {
+       ${{action["c_code"]}}
+    } catch (const RejectException & e) {
+       fatal("Error in action ${{ident}}:${{action.ident}}: "
+             "executed a peek statement with the wrong message "
+             "type specified. ");
+    }
+}
+
+"""
+            )
+        else:
+            prefix = "inline " if inline else ""
+            code(
+                """
+/** \\brief ${{action.desc}} */
+${prefix}void
+$c_ident::${{action.ident}}(${{self.actionParams()}})
+{
+    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
+    ${{action["c_code"]}}
+}
+
+"""
+            )
+
+    def printAppendTransitionComment(self, code):
+        ident = self.ident
+        code(
+            """
+
+#ifndef NDEBUG
+// The comment is only ever printed by the ProtocolTrace debug flag, so
+// avoid formatting it into the stream unless that flag is enabled.
+#define APPEND_TRANSITION_COMMENT(str) do {                          \\
+    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::ProtocolTrace))  \\
+        ${ident}_transitionComment << str;                           \\
+} while (0)
+#else
+#define APPEND_TRANSITION_COMMENT(str) do {} while (0)
+#endif
+"""
+        )
+
     def writeCodeFiles(self, path, includes):
         self.printControllerPython(path)
         self.printControllerHH(path)
         self.printControllerCC(path, includes)
-        self.printCSwitch(path)
+        self.printCSwitch(path, includes)
         self.printCWakeup(path, includes)
 
     def printControllerPython(self, path):
@@ -305,6 +387,7 @@ class $py_ident(RubyController):
 #ifndef __${ident}_CONTROLLER_HH__
 #define __${ident}_CONTROLLER_HH__
 
+#include <cassert>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -363,7 +446,14 @@ class $c_ident : public AbstractController
     bool functionalReadBuffers(PacketPtr&, WriteMask&);
     int functionalWriteBuffers(PacketPtr&);
 
-    void countTransition(${ident}_State state, ${ident}_Event event);
+    void
+    countTransition(${ident}_State state, ${ident}_Event event)
+    {
+        assert(m_possible[state][event]);
+        m_counters[state][event]++;
+        m_event_counters[event]++;
+    }
+
     void possibleTransition(${ident}_State state, ${ident}_Event event);
     uint64_t getEventCount(${ident}_Event event);
     bool isPossible(${ident}_State state, ${ident}_Event event);
@@ -426,6 +516,23 @@ TransitionResult doTransitionWorker(${ident}_Event event,
         code(
             """
                                     Addr addr);
+"""
+        )
+
+        if self.symtab.slicc.fast_transitions:
+            code(
+                """
+
+// The code of each unique transition, numbered, for dispatching through a
+// table indexed by state and event
+template <int N>
+TransitionResult doTransitionCase(${ident}_State& next_state,
+                                  ${{self.actionParams()}});
+"""
+            )
+
+        code(
+            """
 
 ${ident}_Event m_curTransitionEvent;
 ${ident}_State m_curTransitionNextState;
@@ -450,6 +557,10 @@ static int m_num_controllers;
             if proto:
                 code("$proto")
 
+        # Protocols opt in to functional cache warmup by defining the hook
+        if any(func.c_name == "functionalWarmup" for func in self.functions):
+            code("bool hasFunctionalWarmup() const { return true; }")
+
         if self.EntryType != None:
             code(
                 """
@@ -477,32 +588,10 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
 // Actions
 """
         )
-        if self.TBEType != None and self.EntryType != None:
-            for action in self.actions.values():
-                code("/** \\brief ${{action.desc}} */")
-                code(
-                    "void ${{action.ident}}(${{self.TBEType.c_ident}}*& "
-                    "m_tbe_ptr, ${{self.EntryType.c_ident}}*& "
-                    "m_cache_entry_ptr, Addr addr);"
-                )
-        elif self.TBEType != None:
-            for action in self.actions.values():
-                code("/** \\brief ${{action.desc}} */")
-                code(
-                    "void ${{action.ident}}(${{self.TBEType.c_ident}}*& "
-                    "m_tbe_ptr, Addr addr);"
-                )
-        elif self.EntryType != None:
-            for action in self.actions.values():
-                code("/** \\brief ${{action.desc}} */")
-                code(
-                    "void ${{action.ident}}(${{self.EntryType.c_ident}}*& "
-                    "m_cache_entry_ptr, Addr addr);"
-                )
-        else:
-            for action in self.actions.values():
-                code("/** \\brief ${{action.desc}} */")
-                code("void ${{action.ident}}(Addr addr);")
+        for action in self.actions.values():
+            inline = "inline " if self.isInlineAction(action) else ""
+            code("/** \\brief ${{action.desc}} */")
+            code("${inline}void ${{action.ident}}(${{self.actionParams()}});")
 
         # the controller internal variables
         code(
@@ -529,12 +618,10 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
 
         code.write(path, f"{c_ident}.hh")
 
-    def printControllerCC(self, path, includes):
-        """Output the actions for performing the actions"""
+    def printActionIncludes(self, code, includes):
+        """Output the includes the code of the actions needs"""
 
-        code = self.symtab.codeFormatter()
         ident = self.ident
-        c_ident = f"{self.ident}_Controller"
 
         # Unfortunately, clang compilers will throw a "call to function ...
         # that is neither visible in the template definition nor found by
@@ -563,8 +650,6 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
 
         code(
             """
-// Created by slicc definition of Module "${{self.short}}"
-
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -603,6 +688,21 @@ void unset_tbe(${{self.TBEType.c_ident}}*& m_tbe_ptr);
                 code('#include "mem/ruby/protocol/${{var.type.c_ident}}.hh"')
             seen_types.add(var.type.ident)
 
+    def printControllerCC(self, path, includes):
+        """Output the actions for performing the actions"""
+
+        code = self.symtab.codeFormatter()
+        ident = self.ident
+        c_ident = f"{self.ident}_Controller"
+
+        code(
+            """
+// Created by slicc definition of Module "${{self.short}}"
+
+"""
+        )
+        self.printActionIncludes(code, includes)
+
         num_in_ports = len(self.in_ports)
 
         code(
@@ -619,12 +719,11 @@ std::vector<std::vector<statistics::Vector *> >  $c_ident::transVec;
 
 // for adding information to the protocol debug trace
 std::stringstream ${ident}_transitionComment;
-
-#ifndef NDEBUG
-#define APPEND_TRANSITION_COMMENT(str) (${ident}_transitionComment << str)
-#else
-#define APPEND_TRANSITION_COMMENT(str) do {} while (0)
-#endif
+"""
+        )
+        self.printAppendTransitionComment(code)
+        code(
+            """
 
 /** \\brief constructor */
 $c_ident::$c_ident(const Params &p)
@@ -1042,13 +1141,6 @@ $c_ident::collateStats()
     }
 }
 
-void
-$c_ident::countTransition(${ident}_State state, ${ident}_Event event)
-{
-    assert(m_possible[state][event]);
-    m_counters[state][event]++;
-    m_event_counters[event]++;
-}
 void
 $c_ident::possibleTransition(${ident}_State state,
                              ${ident}_Event event)
@@ -1185,80 +1277,10 @@ $c_ident::recordCacheTrace(int cntrl, CacheRecorder* tr)
 // Actions
 """
         )
-        if self.TBEType != None and self.EntryType != None:
-            for action in self.actions.values():
-                if "c_code" not in action:
-                    continue
-
-                code(
-                    """
-/** \\brief ${{action.desc}} */
-void
-$c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, ${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Addr addr)
-{
-    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
-    try {
-       ${{action["c_code"]}}
-    } catch (const RejectException & e) {
-       fatal("Error in action ${{ident}}:${{action.ident}}: "
-             "executed a peek statement with the wrong message "
-             "type specified. ");
-    }
-}
-
-"""
-                )
-        elif self.TBEType != None:
-            for action in self.actions.values():
-                if "c_code" not in action:
-                    continue
-
-                code(
-                    """
-/** \\brief ${{action.desc}} */
-void
-$c_ident::${{action.ident}}(${{self.TBEType.c_ident}}*& m_tbe_ptr, Addr addr)
-{
-    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
-    ${{action["c_code"]}}
-}
-
-"""
-                )
-        elif self.EntryType != None:
-            for action in self.actions.values():
-                if "c_code" not in action:
-                    continue
-
-                code(
-                    """
-/** \\brief ${{action.desc}} */
-void
-$c_ident::${{action.ident}}(${{self.EntryType.c_ident}}*& m_cache_entry_ptr, Addr addr)
-{
-    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
-    ${{action["c_code"]}}
-}
-
-"""
-                )
-        else:
-            for action in self.actions.values():
-                if "c_code" not in action:
-                    continue
-
-                code(
-                    """
-/** \\brief ${{action.desc}} */
-void
-$c_ident::${{action.ident}}(Addr addr)
-{
-    DPRINTF(RubyGenerated, "executing ${{action.ident}}\\n");
-    ${{action["c_code"]}}
-}
+        for action in self.actions.values():
+            if not self.isInlineAction(action):
+                self.printAction(code, action)
 
-"""
-                )
         for func in self.functions:
             code(func.generateCode())
 
@@ -1496,17 +1518,152 @@ ${ident}_Controller::wakeup()
 
         code.write(path, f"{self.ident}_Wakeup.cc")
 
-    def printCSwitch(self, path):
+    def transitionCases(self):
+        """Map the code of each unique transition to the transitions which
+        share it"""
+        ident = self.ident
+
+        # This map will allow suppress generating duplicate code
+        cases = OrderedDict()
+
+        for trans in self.transitions:
+            case_string = "%s_State_%s, %s_Event_%s" % (
+                self.ident,
+                trans.state.ident,
+                self.ident,
+                trans.event.ident,
+            )
+
+            case = self.symtab.codeFormatter()
+            # Only set next_state if it changes
+            if trans.state != trans.nextState:
+                if trans.nextState.isWildcard():
+                    # When * is encountered as an end state of a transition,
+                    # the next state is determined by calling the
+                    # machine-specific getNextState function. The next state
+                    # is determined before any actions of the transition
+                    # execute, and therefore the next state calculation cannot
+                    # depend on any of the transitionactions.
+                    case(
+                        "next_state = getNextState(addr); "
+                        "m_curTransitionNextState = next_state;"
+                    )
+                else:
+                    ns_ident = trans.nextState.ident
+                    case(
+                        "next_state = ${ident}_State_${ns_ident}; "
+                        "m_curTransitionNextState = next_state;"
+                    )
+
+            actions = trans.actions
+            request_types = trans.request_types
+
+            # Check for resources
+            case_sorter = []
+            res = trans.resources
+            for key, val in res.items():
+                val = f"""
+if (!{key.code}.areNSlotsAvailable({val}, clockEdge()))
+    return TransitionResult_ResourceStall;
+"""
+                case_sorter.append(val)
+
+            # Check all of the request_types for resource constraints
+            for request_type in request_types:
+                val = """
+if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
+    return TransitionResult_ResourceStall;
+}
+""" % (
+                    self.ident,
+                    request_type.ident,
+                )
+                case_sorter.append(val)
+
+            # Emit the code sequences in a sorted order.  This makes the
+            # output deterministic (without this the output order can vary
+            # since Map's keys() on a vector of pointers is not deterministic
+            for c in sorted(case_sorter):
+                case("$c")
+
+            # Record access types for this transition
+            for request_type in request_types:
+                case(
+                    "recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);"
+                )
+
+            # Figure out if we stall
+            stall = False
+            for action in actions:
+                if action.ident == "z_stall":
+                    stall = True
+                    break
+
+            if stall:
+                case("return TransitionResult_ProtocolStall;")
+            else:
+                if self.TBEType != None and self.EntryType != None:
+                    for action in actions:
+                        case(
+                            "${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);"
+                        )
+                elif self.TBEType != None:
+                    for action in actions:
+                        case("${{action.ident}}(m_tbe_ptr, addr);")
+                elif self.EntryType != None:
+                    for action in actions:
+                        case("${{action.ident}}(m_cache_entry_ptr, addr);")
+                else:
+                    for action in actions:
+                        case("${{action.ident}}(addr);")
+                case("return TransitionResult_Valid;")
+
+            case = str(case)
+
+            # Look to see if this transition code is unique.
+            if case not in cases:
+                cases[case] = []
+
+            cases[case].append(case_string)
+
+        return cases
+
+    def printCSwitch(self, path, includes):
         """Output switch statement for transition table"""
 
         code = self.symtab.codeFormatter()
         ident = self.ident
+        inline_actions = [
+            action
+            for action in self.actions.values()
+            if self.isInlineAction(action)
+        ]
+
+        fast = self.symtab.slicc.fast_transitions
 
         code(
             """
 // ${ident}: ${{self.short}}
 
-#include <cassert>
+"""
+        )
+        if fast:
+            code("#include <array>")
+        if inline_actions:
+            # The inline actions need everything the controller source file
+            # includes for its actions.
+            self.printActionIncludes(code, includes)
+            code(
+                """
+#include "base/logging.hh"
+#include "base/trace.hh"
+
+"""
+            )
+        else:
+            code("#include <cassert>")
+            code(
+                """
 
 #include "base/logging.hh"
 #include "base/trace.hh"
@@ -1518,16 +1675,35 @@ ${ident}_Controller::wakeup()
 #include "mem/ruby/protocol/Types.hh"
 #include "mem/ruby/system/RubySystem.hh"
 
+"""
+            )
+
+        code(
+            """
 #define HASH_FUN(state, event)  ((int(state)*${ident}_Event_NUM)+int(event))
 
 #define GET_TRANSITION_COMMENT() (${ident}_transitionComment.str())
-#define CLEAR_TRANSITION_COMMENT() (${ident}_transitionComment.str(""))
+#define CLEAR_TRANSITION_COMMENT() do {                              \\
+    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::ProtocolTrace))  \\
+        ${ident}_transitionComment.str("");                          \\
+} while (0)
 
 namespace gem5
 {
 
 namespace ruby
 {
+"""
+        )
+        if inline_actions:
+            self.printAppendTransitionComment(code)
+            code()
+            code("// Actions")
+            for action in inline_actions:
+                self.printAction(code, action, inline=True)
+
+        code(
+            """
 
 TransitionResult
 ${ident}_Controller::doTransition(${ident}_Event event,
@@ -1592,13 +1768,19 @@ TransitionResult result =
 
         port_to_buf_map, in_msg_bufs, msg_bufs = self.getBufferMaps(ident)
 
+        count_transition = "countTransition(state, event);"
+        if fast:
+            # The transition profile is compiled out along with the
+            # ProtocolTrace output when tracing isn't built in.
+            count_transition = "if (TRACING_ON)\n    " + count_transition
+
         code(
             """
 
 if (result == TransitionResult_Valid) {
     DPRINTF(RubyGenerated, "next_state: %s\\n",
             ${ident}_State_to_string(next_state));
-    countTransition(state, event);
+    $count_transition
 
     DPRINTFR(ProtocolTrace, "%15d %3s %10s%20s %6s>%-6s %#x %s\\n",
              curTick(), m_version, "${ident}",
@@ -1646,9 +1828,33 @@ return result;
 """
         )
         code.dedent()
+        code("}")
+
+        cases = self.transitionCases()
+
+        if fast:
+            # Instead of a switch on HASH_FUN(state, event), which compilers
+            # can lower to several jump tables and bit tests, number the
+            # unique code blocks, define each as a specialization of
+            # doTransitionCase<N>(), and dispatch through a dense table of
+            # pointers to them.
+            for num, case in enumerate(cases, 1):
+                case = case.rstrip()
+                code(
+                    """
+
+template <>
+TransitionResult
+${ident}_Controller::doTransitionCase<$num>(${ident}_State& next_state,
+    ${{self.actionParams()}})
+{
+    $case
+}
+"""
+                )
+
         code(
             """
-}
 
 TransitionResult
 ${ident}_Controller::doTransitionWorker(${ident}_Event event,
@@ -1675,124 +1881,65 @@ ${ident}_Controller::doTransitionWorker(${ident}_Event event,
 {
     m_curTransitionEvent = event;
     m_curTransitionNextState = next_state;
-    switch(HASH_FUN(state, event)) {
 """
         )
 
-        # This map will allow suppress generating duplicate code
-        cases = OrderedDict()
+        if fast:
+            args = ["next_state"]
+            if self.TBEType != None:
+                args.append("m_tbe_ptr")
+            if self.EntryType != None:
+                args.append("m_cache_entry_ptr")
+            args.append("addr")
+            args = ", ".join(args)
+            code.indent()
+            code(
+                """
 
-        for trans in self.transitions:
-            case_string = "%s_State_%s, %s_Event_%s" % (
-                self.ident,
-                trans.state.ident,
-                self.ident,
-                trans.event.ident,
+using CaseFunc = TransitionResult (${ident}_Controller::*)(
+    ${ident}_State&, ${{self.actionParams()}});
+static constexpr auto caseTable = []() {
+    std::array<CaseFunc, ${ident}_State_NUM * ${ident}_Event_NUM> table{};
+"""
             )
-
-            case = self.symtab.codeFormatter()
-            # Only set next_state if it changes
-            if trans.state != trans.nextState:
-                if trans.nextState.isWildcard():
-                    # When * is encountered as an end state of a transition,
-                    # the next state is determined by calling the
-                    # machine-specific getNextState function. The next state
-                    # is determined before any actions of the transition
-                    # execute, and therefore the next state calculation cannot
-                    # depend on any of the transitionactions.
-                    case(
-                        "next_state = getNextState(addr); "
-                        "m_curTransitionNextState = next_state;"
-                    )
-                else:
-                    ns_ident = trans.nextState.ident
-                    case(
-                        "next_state = ${ident}_State_${ns_ident}; "
-                        "m_curTransitionNextState = next_state;"
+            code.indent()
+            for num, transitions in enumerate(cases.values(), 1):
+                for trans in transitions:
+                    code(
+                        "table[HASH_FUN($trans)] = "
+                        "&${ident}_Controller::doTransitionCase<$num>;"
                     )
-
-            actions = trans.actions
-            request_types = trans.request_types
-
-            # Check for resources
-            case_sorter = []
-            res = trans.resources
-            for key, val in res.items():
-                val = f"""
-if (!{key.code}.areNSlotsAvailable({val}, clockEdge()))
-    return TransitionResult_ResourceStall;
-"""
-                case_sorter.append(val)
-
-            # Check all of the request_types for resource constraints
-            for request_type in request_types:
-                val = """
-if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
-    return TransitionResult_ResourceStall;
+            code.dedent()
+            code(
+                """
+    return table;
+}();
+
+CaseFunc func = caseTable[HASH_FUN(state, event)];
+if (func == nullptr) {
+    panic("Invalid transition\\n"
+          "%s time: %d addr: %#x event: %s state: %s\\n",
+          name(), curCycle(), addr, event, state);
 }
-""" % (
-                    self.ident,
-                    request_type.ident,
-                )
-                case_sorter.append(val)
-
-            # Emit the code sequences in a sorted order.  This makes the
-            # output deterministic (without this the output order can vary
-            # since Map's keys() on a vector of pointers is not deterministic
-            for c in sorted(case_sorter):
-                case("$c")
-
-            # Record access types for this transition
-            for request_type in request_types:
-                case(
-                    "recordRequestType(${ident}_RequestType_${{request_type.ident}}, addr);"
-                )
-
-            # Figure out if we stall
-            stall = False
-            for action in actions:
-                if action.ident == "z_stall":
-                    stall = True
-                    break
-
-            if stall:
-                case("return TransitionResult_ProtocolStall;")
-            else:
-                if self.TBEType != None and self.EntryType != None:
-                    for action in actions:
-                        case(
-                            "${{action.ident}}(m_tbe_ptr, m_cache_entry_ptr, addr);"
-                        )
-                elif self.TBEType != None:
-                    for action in actions:
-                        case("${{action.ident}}(m_tbe_ptr, addr);")
-                elif self.EntryType != None:
-                    for action in actions:
-                        case("${{action.ident}}(m_cache_entry_ptr, addr);")
-                else:
-                    for action in actions:
-                        case("${{action.ident}}(addr);")
-                case("return TransitionResult_Valid;")
-
-            case = str(case)
-
-            # Look to see if this transition code is unique.
-            if case not in cases:
-                cases[case] = []
-
-            cases[case].append(case_string)
+return (this->*func)($args);
+"""
+            )
+            code.dedent()
+            code("}")
+        else:
+            code("    switch(HASH_FUN(state, event)) {")
 
-        # Walk through all of the unique code blocks and spit out the
-        # corresponding case statement elements
-        for case, transitions in cases.items():
-            # Iterative over all the multiple transitions that share
-            # the same code
-            for trans in transitions:
-                code("  case HASH_FUN($trans):")
-            code("    $case\n")
+            # Walk through all of the unique code blocks and spit out the
+            # corresponding case statement elements
+            for case, transitions in cases.items():
+                # Iterative over all the multiple transitions that share
+                # the same code
+                for trans in transitions:
+                    code("  case HASH_FUN($trans):")
+                code("    $case\n")
 
-        code(
-            """
+            code(
+                """
       default:
         panic("Invalid transition\\n"
               "%s time: %d addr: %#x event: %s state: %s\\n",
@@ -1801,6 +1948,11 @@ if (!checkResourceAvailable(%s_RequestType_%s, addr)) {
 
     return TransitionResult_Valid;
 }
+"""
+            )
+
+        code(
+            """
 
 } // namespace ruby
 } // namespace gem5
@@ -34,7 +34,7 @@ from m5.util import warn
 
 from ...utils.override import *
 
-from typing import Optional
+from typing import List, Optional
 
 
 class SimpleSwitchableProcessor(SwitchableProcessor):
@@ -115,6 +115,14 @@ class SimpleSwitchableProcessor(SwitchableProcessor):
             self._mem_mode = MemMode.ATOMIC_NONCACHING
         board.set_mem_mode(self._mem_mode)
 
+    def get_start_cores(self) -> List[SimpleCore]:
+        """Returns the cores used at the start of the simulation."""
+        return self._switchable_cores[self._start_key]
+
+    def get_switch_cores(self) -> List[SimpleCore]:
+        """Returns the cores switched to by the first call to "switch"."""
+        return self._switchable_cores[self._switch_key]
+
     def switch(self):
         """Switches to the "switched out" cores."""
         if self._current_is_start:
@@ -0,0 +1,240 @@
+# Copyright (c) 2023 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from enum import Enum
+from math import sqrt
+from statistics import NormalDist, mean, stdev
+from typing import Generator, List, Optional
+
+from m5.util import fatal
+
+from ..components.processors.cpu_types import CPUTypes
+from ..components.processors.simple_switchable_processor import (
+    SimpleSwitchableProcessor,
+)
+
+
+class SMARTSPhase(Enum):
+    """The phases a SMARTS sampling unit goes through."""
+
+    FUNCTIONAL_WARMING = "functional warming"
+    DETAILED_WARMING = "detailed warming"
+    MEASUREMENT = "measurement"
+
+
+class SMARTSSampler:
+    """
+    This class drives SMARTS-style systematic sampling (Wunderlich et al.,
+    ISCA 2003) on a SimpleSwitchableProcessor.
+
+    The run is split into sampling units of `sampling_period` instructions.
+    Each unit starts with functional warming on the atomic cores, which keeps
+    the caches (and optionally the branch predictor) warm while executing at
+    full speed. The last `detailed_warming + measurement` instructions of a
+    unit run on the detailed cores: the first `detailed_warming` instructions
+    fill the pipeline and the remaining `measurement` instructions are timed.
+
+    The sampler is driven by MAX_INSTS exit events. Pass the generator
+    returned by `get_generator()` to the Simulator:
+
+    ```
+    sampler = SMARTSSampler(processor, sampling_period=1000000)
+    simulator = Simulator(
+        board=board,
+        on_exit_event={ExitEvent.MAX_INSTS: sampler.get_generator()},
+    )
+    simulator.run()
+    print(sampler.get_cpi(), sampler.get_confidence_interval())
+    ```
+
+    **Warning:** SMARTS sampling only works with a single, single-threaded
+    core. The cycle counts are read from the CPU statistics, so the stats
+    must not be reset while the sampler is running.
+    """
+
+    def __init__(
+        self,
+        processor: SimpleSwitchableProcessor,
+        sampling_period: int,
+        detailed_warming: int = 2000,
+        measurement: int = 1000,
+        confidence: float = 0.997,
+        max_samples: Optional[int] = None,
+        share_branch_predictor: bool = True,
+    ) -> None:
+        """
+        :param processor: The processor to sample. It must start on atomic
+        cores and switch to a detailed core type.
+        :param sampling_period: The number of instructions in a sampling unit.
+        :param detailed_warming: The number of instructions simulated on the
+        detailed cores before each measurement.
+        :param measurement: The number of instructions measured per sample.
+        :param confidence: The confidence level of the reported CPI interval.
+        :param max_samples: Exit the simulation loop after this many samples.
+        If not set, sampling continues until the workload exits.
+        :param share_branch_predictor: If True, the atomic cores train the
+        branch predictor of the detailed cores during functional warming.
+        This must be set before the board is instantiated.
+        """
+
+        if not isinstance(processor, SimpleSwitchableProcessor):
+            fatal("SMARTS sampling requires a SimpleSwitchableProcessor.")
+
+        if processor.get_num_cores() != 1:
+            fatal("SMARTS sampling only works with one core.")
+
+        fast_cores = processor.get_start_cores()
+        detailed_cores = processor.get_switch_cores()
+
+        if fast_cores[0].get_type() != CPUTypes.ATOMIC:
+            fatal(
+                "SMARTS sampling requires the processor to start on atomic "
+                "cores for functional warming."
+            )
+
+        if detailed_cores[0].get_type() in (CPUTypes.ATOMIC, CPUTypes.KVM):
+            fatal(
+                "SMARTS sampling requires the processor to switch to a "
+                "detailed core type."
+            )
+
+        if measurement <= 0:
+            fatal("The SMARTS measurement length must be positive.")
+
+        if sampling_period <= detailed_warming + measurement:
+            fatal(
+                "The SMARTS sampling period must be larger than the sum of "
+                "the detailed warming and measurement lengths."
+            )
+
+        if not 0 < confidence < 1:
+            fatal("The SMARTS confidence level must be between 0 and 1.")
+
+        self._processor = processor
+        self._functional_warming = (
+            sampling_period - detailed_warming - measurement
+        )
+        self._detailed_warming = detailed_warming
+        self._measurement = measurement
+        self._confidence = confidence
+        self._max_samples = max_samples
+
+        if share_branch_predictor:
+            for fast, detailed in zip(fast_cores, detailed_cores):
+                fast.get_simobject().branchPred = (
+                    detailed.get_simobject().branchPred
+                )
+
+        self._phase = SMARTSPhase.FUNCTIONAL_WARMING
+        self._start_cycles = 0
+        self._samples: List[float] = []
+
+        # The board has not been instantiated yet, so this sets the
+        # max_insts_any_thread parameter of the atomic core.
+        self._schedule(self._functional_warming, False)
+
+    def _schedule(self, insts: int, board_initialized: bool = True) -> None:
+        for core in self._processor.get_cores():
+            core._set_inst_stop_any_thread(insts, board_initialized)
+
+    def _current_cycles(self) -> int:
+        return (
+            self._processor.get_cores()[0]
+            .get_simobject()
+            .getCurrentCycleCount()
+        )
+
+    def _start_measurement(self) -> None:
+        self._phase = SMARTSPhase.MEASUREMENT
+        self._start_cycles = self._current_cycles()
+        self._schedule(self._measurement)
+
+    def get_generator(self) -> Generator[bool, None, None]:
+        """
+        Returns the generator handling MAX_INSTS exit events. It yields True,
+        exiting the simulation loop, once `max_samples` samples were taken.
+        """
+        while True:
+            if self._phase == SMARTSPhase.FUNCTIONAL_WARMING:
+                self._processor.switch()
+                if self._detailed_warming:
+                    self._phase = SMARTSPhase.DETAILED_WARMING
+                    self._schedule(self._detailed_warming)
+                else:
+                    self._start_measurement()
+            elif self._phase == SMARTSPhase.DETAILED_WARMING:
+                self._start_measurement()
+            else:
+                cycles = self._current_cycles() - self._start_cycles
+                self._samples.append(cycles / self._measurement)
+
+                if (
+                    self._max_samples is not None
+                    and len(self._samples) >= self._max_samples
+                ):
+                    while True:
+                        yield True
+
+                self._processor.switch()
+                self._phase = SMARTSPhase.FUNCTIONAL_WARMING
+                self._schedule(self._functional_warming)
+            yield False
+
+    def get_phase(self) -> SMARTSPhase:
+        """Returns the phase of the current sampling unit."""
+        return self._phase
+
+    def get_samples(self) -> List[float]:
+        """Returns the CPI measured in each sample."""
+        return self._samples
+
+    def get_cpi(self) -> float:
+        """Returns the estimated CPI, i.e., the mean CPI of the samples."""
+        if not self._samples:
+            fatal("No SMARTS samples have been taken.")
+        return mean(self._samples)
+
+    def get_confidence_interval(self) -> float:
+        """
+        Returns the half-width of the confidence interval of the estimated
+        CPI at the configured confidence level.
+        """
+        if len(self._samples) < 2:
+            fatal("At least two SMARTS samples are needed for an interval.")
+        z = NormalDist().inv_cdf((1 + self._confidence) / 2)
+        return z * stdev(self._samples) / sqrt(len(self._samples))
+
+    def get_required_samples(self, relative_error: float = 0.03) -> int:
+        """
+        Returns the number of samples needed to reach the given relative
+        error at the configured confidence level, based on the coefficient
+        of variation of the samples taken so far.
+        """
+        if len(self._samples) < 2:
+            fatal("At least two SMARTS samples are needed for an estimate.")
+        z = NormalDist().inv_cdf((1 + self._confidence) / 2)
+        variation = stdev(self._samples) / mean(self._samples)
+        return int((z * variation / relative_error) ** 2) + 1
@@ -191,7 +191,7 @@ def simulate(*args, **kwargs):
         # Reset to put the stats in a consistent state.
         stats.reset()
 
-    if _drain_manager.isDrained():
+    if _drain_manager.state() == _m5.drain.DrainState.Drained:
         _drain_manager.resume()
 
     # We flush stdout and stderr before and after the simulation to ensure the
@@ -298,6 +298,25 @@ def drain():
     assert _drain_manager.isDrained(), "Drain state inconsistent"
 
 
+def drainObjects(objs):
+    """Drain a subset of the SimObjects in the simulator.
+
+    Only the objects in objs are drained, the rest of the simulator
+    (e.g., the memory system) keeps running while they drain. This is
+    enough to hand over CPUs as long as the memory mode of the system
+    doesn't change. Use drain() to drain the whole simulator.
+
+    """
+
+    cc_objs = [obj.getCCObject() for obj in objs]
+    while not _drain_manager.tryDrainObjects(cc_objs):
+        # WARNING: if a valid exit event occurs while draining, it
+        # will not get returned to the user script
+        exit_event = _m5.event.simulate()
+        while exit_event.getCause() != "Finished drain":
+            exit_event = simulate()
+
+
 def memWriteback(root):
     for obj in root.descendants():
         obj.memWriteback()
@@ -331,16 +350,22 @@ def _changeMemoryMode(system, mode):
         print("System already in target mode. Memory mode unchanged.")
 
 
-def switchCpus(system, cpuList, verbose=True):
+def switchCpus(system, cpuList, verbose=True, full_drain=False):
     """Switch CPUs in a system.
 
     Note: This method may switch the memory mode of the system if that
     is required by the CPUs. It may also flush all caches in the
     system.
 
+    If the memory mode doesn't change, only the CPUs being switched
+    are drained and the memory system keeps running during the
+    handover. The whole simulator is drained if the memory mode
+    changes or if full_drain is set.
+
     Arguments:
       system -- Simulated system.
       cpuList -- (old_cpu, new_cpu) tuples
+      full_drain -- Always drain the whole simulator
     """
 
     if verbose:
@@ -388,7 +413,17 @@ def switchCpus(system, cpuList, verbose=True):
     except KeyError:
         raise RuntimeError(f"Invalid memory mode ({memory_mode_name})")
 
-    drain()
+    change_memory_mode = system.getMemoryMode() != memory_mode
+    if full_drain or change_memory_mode:
+        drain()
+    else:
+        # The new CPUs have to be drained as well, otherwise they
+        # wouldn't be resumed (and activated) after the handover.
+        cpu_objs = {}
+        for cpu in old_cpus + new_cpus:
+            for obj in cpu.descendants():
+                cpu_objs[id(obj)] = obj
+        drainObjects(list(cpu_objs.values()))
 
     # Now all of the CPUs are ready to be switched out
     for old_cpu, new_cpu in cpuList:
@@ -396,7 +431,7 @@ def switchCpus(system, cpuList, verbose=True):
 
     # Change the memory mode if required. We check if this is needed
     # to avoid printing a warning if no switch was performed.
-    if system.getMemoryMode() != memory_mode:
+    if change_memory_mode:
         # Flush the memory system if we are switching to a memory mode
         # that disables caches. This typically happens when switching to a
         # hardware virtualized CPU.
@@ -50,6 +50,22 @@ class Process(SimObject):
     )
     kvmInSE = Param.Bool("false", "initialize the process for KvmCPU in SE")
     maxStackSize = Param.MemorySize("64MiB", "maximum size of the stack")
+    # Direct host access to guest memory bypasses the memory system, so it
+    # is only correct if no caches hold copies of the I/O buffers, e.g., if
+    # the system doesn't have caches.
+    zeroCopyIO = Param.Bool(
+        False,
+        "let I/O syscalls access the backing store of guest memory directly",
+    )
+    # File-backed mmaps map the file copy-on-write into the backing store of
+    # guest memory instead of copying it page by page. Like zeroCopyIO, this
+    # writes the backing store behind the back of the caches, so it assumes
+    # that they don't hold stale copies of newly allocated frames.
+    directFileMmap = Param.Bool(
+        False,
+        "map file-backed mmap pages directly into the backing store of "
+        "guest memory",
+    )
 
     uid = Param.Int(100, "user id")
     euid = Param.Int(100, "effective user id")
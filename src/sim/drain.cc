@@ -52,7 +52,8 @@ DrainManager DrainManager::_instance;
 
 DrainManager::DrainManager()
     : _count(0),
-      _state(DrainState::Running)
+      _state(DrainState::Running),
+      _partiallyDrained(false)
 {
 }
 
@@ -63,7 +64,7 @@ DrainManager::~DrainManager()
 bool
 DrainManager::tryDrain()
 {
-    panic_if(_state == DrainState::Drained,
+    panic_if(_state == DrainState::Drained && !_partiallyDrained,
              "Trying to drain a drained system\n");
 
     panic_if(_count != 0,
@@ -84,6 +85,7 @@ DrainManager::tryDrain()
     if (_count == 0) {
         DPRINTF(Drain, "Drain done.\n");
         _state = DrainState::Drained;
+        _partiallyDrained = false;
         return true;
     } else {
         DPRINTF(Drain, "Need another drain cycle. %u/%u objects not ready.\n",
@@ -92,6 +94,52 @@ DrainManager::tryDrain()
     }
 }
 
+bool
+DrainManager::tryDrainObjects(const std::vector<Drainable *> &objs)
+{
+    if (_state == DrainState::Drained) {
+        // A previous drain (e.g., the previous CPU handover) has not
+        // been resumed yet. Nothing needs to be done unless some of
+        // the objects weren't part of it.
+        bool all_drained = std::all_of(objs.begin(), objs.end(),
+            [](Drainable *obj) {
+                return obj->drainState() == DrainState::Drained;
+            });
+        if (all_drained) {
+            DPRINTF(Drain, "All %u objects are already drained.\n",
+                    objs.size());
+            return true;
+        }
+    }
+
+    panic_if(_count != 0,
+             "Drain counter must be zero at the start of a drain cycle\n");
+
+    DPRINTF(Drain, "Trying to drain %u of %u objects.\n", objs.size(),
+            drainableCount());
+    _state = DrainState::Draining;
+    for (auto *obj : objs) {
+        DrainState status = obj->dmDrain();
+        if (debug::Drain && status != DrainState::Drained) {
+            Named *temp = dynamic_cast<Named*>(obj);
+            if (temp)
+                DPRINTF(Drain, "Failed to drain %s\n", temp->name());
+        }
+        _count += status == DrainState::Drained ? 0 : 1;
+    }
+
+    if (_count == 0) {
+        DPRINTF(Drain, "Partial drain done.\n");
+        _state = DrainState::Drained;
+        _partiallyDrained = true;
+        return true;
+    } else {
+        DPRINTF(Drain, "Need another drain cycle. %u/%u objects not ready.\n",
+                _count, objs.size());
+        return false;
+    }
+}
+
 void
 DrainManager::resume()
 {
@@ -129,6 +177,7 @@ DrainManager::resume()
     } while (!allInState(DrainState::Running));
 
     _state = DrainState::Running;
+    _partiallyDrained = false;
 }
 
 void
@@ -108,6 +108,25 @@ class DrainManager
      */
     bool tryDrain();
 
+    /**
+     * Try to drain a subset of the objects in the system.
+     *
+     * This works like tryDrain(), but only the objects in objs are
+     * drained while the rest of the simulator keeps running. It is
+     * used to hand over CPUs without draining the memory system,
+     * which is only safe if the timing model of the memory system
+     * doesn't change. Once the objects have been drained, the
+     * simulator is in the Drained state, but isDrained() returns
+     * false until a full drain has been completed. Objects can be
+     * drained again before the simulator is resumed, e.g., by two
+     * CPU handovers in a row.
+     *
+     * @param objs Objects to drain.
+     * @return true if all objects were drained successfully, false if
+     * more simulation is needed.
+     */
+    bool tryDrainObjects(const std::vector<Drainable *> &objs);
+
     /**
      * Resume normal simulation in a Drained system.
      *
@@ -142,7 +161,11 @@ class DrainManager
      *
      * @ingroup api_drain
      */
-    bool isDrained() const { return _state == DrainState::Drained; }
+    bool
+    isDrained() const
+    {
+        return _state == DrainState::Drained && !_partiallyDrained;
+    }
 
     /**
      * Get the simulators global drain state
@@ -192,6 +215,9 @@ class DrainManager
     /** Global simulator drain state */
     DrainState _state;
 
+    /** Set if only a subset of the objects has been drained */
+    bool _partiallyDrained;
+
     /** Singleton instance of the drain manager */
     static DrainManager _instance;
 };
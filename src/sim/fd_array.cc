@@ -36,6 +36,7 @@
 
 #include <array>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "base/logging.hh"
@@ -283,6 +284,7 @@ FDArray::restoreFileOffsets()
 int
 FDArray::allocFD(std::shared_ptr<FDEntry> in)
 {
+    std::lock_guard<std::mutex> lock(_fdMutex);
     for (int i = 0; i < _fdArray.size(); i++) {
         std::shared_ptr<FDEntry> fdp = _fdArray[i];
         if (!fdp) {
@@ -319,6 +321,7 @@ std::shared_ptr<FDEntry>
 FDArray::getFDEntry(int tgt_fd)
 {
     assert(0 <= tgt_fd && tgt_fd < _fdArray.size());
+    std::lock_guard<std::mutex> lock(_fdMutex);
     return _fdArray[tgt_fd];
 }
 
@@ -326,6 +329,7 @@ void
 FDArray::setFDEntry(int tgt_fd, std::shared_ptr<FDEntry> fdep)
 {
     assert(0 <= tgt_fd && tgt_fd < _fdArray.size());
+    std::lock_guard<std::mutex> lock(_fdMutex);
     _fdArray[tgt_fd] = fdep;
 }
 
@@ -335,6 +339,7 @@ FDArray::closeFDEntry(int tgt_fd)
     if (tgt_fd >= _fdArray.size() || tgt_fd < 0)
         return -EBADF;
 
+    std::lock_guard<std::mutex> lock(_fdMutex);
     int sim_fd = -1;
     auto hbfdp = std::dynamic_pointer_cast<HBFDEntry>(_fdArray[tgt_fd]);
     if (hbfdp)
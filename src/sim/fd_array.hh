@@ -35,6 +35,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "sim/fd_entry.hh"
@@ -144,6 +145,12 @@ class FDArray : public Serializable
     static constexpr size_t _numFDs {1024};
     std::array<std::shared_ptr<FDEntry>, _numFDs> _fdArray;
 
+    /**
+     * Lock protecting _fdArray, which may be shared by threads simulated
+     * in different event queues.
+     */
+    std::mutex _fdMutex;
+
     /**
      * Hold param strings passed from the Process class which indicate
      * the filename for each of the corresponding files or some keyword
@@ -28,6 +28,9 @@
 
 #include <sim/futex_map.hh>
 
+#include "cpu/base.hh"
+#include "sim/eventq.hh"
+
 namespace gem5
 {
 
@@ -49,6 +52,36 @@ WaiterState::checkMask(int wakeup_bitmask) const
     return bitmask & wakeup_bitmask;
 }
 
+void
+FutexMap::lock()
+{
+    mutex.lock();
+    ++lockDepth;
+}
+
+void
+FutexMap::unlock()
+{
+    std::vector<ThreadContext *> wakeups;
+    if (--lockDepth == 0)
+        wakeups.swap(pendingWakeups);
+    mutex.unlock();
+
+    for (auto *tc : wakeups) {
+        // The thread may be simulated in a different event queue.
+        EventQueue::ScopedMigration migrate(
+                tc->getCpuPtr()->eventQueue());
+        tc->activate();
+    }
+}
+
+void
+FutexMap::wake(ThreadContext *tc)
+{
+    waitingTcs.erase(tc);
+    pendingWakeups.push_back(tc);
+}
+
 void
 FutexMap::suspend(Addr addr, uint64_t tgid, ThreadContext *tc)
 {
@@ -58,6 +91,8 @@ FutexMap::suspend(Addr addr, uint64_t tgid, ThreadContext *tc)
 int
 FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
 {
+    std::lock_guard<FutexMap> guard(*this);
+
     FutexKey key(addr, tgid);
     auto it = find(key);
 
@@ -72,11 +107,9 @@ FutexMap::wakeup(Addr addr, uint64_t tgid, int count)
         // memory addresses outside of syscalls, so we
         // must only count threads that were actually
         // woken up by this syscall.
-        auto& tc = waiterList.front().tc;
-        tc->activate();
+        wake(waiterList.front().tc);
         woken_up++;
         waiterList.pop_front();
-        waitingTcs.erase(tc);
     }
 
     if (waiterList.empty())
@@ -89,6 +122,8 @@ void
 FutexMap::suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
                int bitmask)
 {
+    std::lock_guard<FutexMap> guard(*this);
+
     FutexKey key(addr, tgid);
     auto it = find(key);
 
@@ -107,6 +142,8 @@ FutexMap::suspend_bitset(Addr addr, uint64_t tgid, ThreadContext *tc,
 int
 FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
 {
+    std::lock_guard<FutexMap> guard(*this);
+
     FutexKey key(addr, tgid);
     auto it = find(key);
 
@@ -122,8 +159,7 @@ FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
         WaiterState& waiter = *iter;
 
         if (waiter.checkMask(bitmask)) {
-            waiter.tc->activate();
-            waitingTcs.erase(waiter.tc);
+            wake(waiter.tc);
             iter = waiterList.erase(iter);
             woken_up++;
         } else {
@@ -140,6 +176,8 @@ FutexMap::wakeup_bitset(Addr addr, uint64_t tgid, int bitmask)
 int
 FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
 {
+    std::lock_guard<FutexMap> guard(*this);
+
     FutexKey key1(addr1, tgid);
     auto it1 = find(key1);
 
@@ -150,7 +188,7 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
     auto &waiterList1 = it1->second;
 
     while (!waiterList1.empty() && woken_up < count) {
-        waiterList1.front().tc->activate();
+        wake(waiterList1.front().tc);
         waiterList1.pop_front();
         woken_up++;
     }
@@ -168,15 +206,17 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
     FutexKey key2(addr2, tgid);
     auto it2 = find(key2);
 
-    if (it2 == end() && requeued > 0) {
-        insert({key2, tmpList});
+    if (it2 == end()) {
+        if (requeued > 0)
+            insert({key2, tmpList});
     } else {
         it2->second.insert(it2->second.end(),
                            tmpList.begin(), tmpList.end());
     }
 
+    // Inserting key2 may have invalidated it1.
     if (waiterList1.empty())
-        erase(it1);
+        erase(key1);
 
     return woken_up + requeued;
 }
@@ -184,6 +224,7 @@ FutexMap::requeue(Addr addr1, uint64_t tgid, int count, int count2, Addr addr2)
 bool
 FutexMap::is_waiting(ThreadContext *tc)
 {
+    std::lock_guard<FutexMap> guard(*this);
     return waitingTcs.find(tc) != waitingTcs.end();
 }
 
@@ -29,8 +29,10 @@
 #ifndef __FUTEX_MAP_HH__
 #define __FUTEX_MAP_HH__
 
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <cpu/thread_context.hh>
 
@@ -105,10 +107,26 @@ typedef std::list<WaiterState> WaiterList;
 
 /**
  * FutexMap class holds a map of all futexes used in the system
+ *
+ * The threads of a process may be simulated by CPUs in different event
+ * queues, so all operations are serialized by a lock. Callers which need
+ * a sequence of operations to be atomic (e.g., checking the futex value
+ * before suspending) can hold the lock using lock() and unlock(). Waiters
+ * are only activated once the lock has been released, since activating a
+ * thread in a different event queue requires migrating to that queue.
  */
 class FutexMap : public std::unordered_map<FutexKey, WaiterList>
 {
   public:
+    /** Take the lock protecting the map, the lock is recursive */
+    void lock();
+
+    /**
+     * Release the lock protecting the map. Releasing the outermost lock
+     * activates the threads woken up while it was held.
+     */
+    void unlock();
+
     /** Inserts a futex into the map with one waiting TC */
     void suspend(Addr addr, uint64_t tgid, ThreadContext *tc);
 
@@ -139,8 +157,18 @@ class FutexMap : public std::unordered_map<FutexKey, WaiterList>
     bool is_waiting(ThreadContext *tc);
 
   private:
+    /** Queue a woken up thread for activation once the lock is released */
+    void wake(ThreadContext *tc);
 
     std::unordered_set<ThreadContext *> waitingTcs;
+
+    std::recursive_mutex mutex;
+
+    /** Number of times the lock is held by the owning thread */
+    int lockDepth = 0;
+
+    /** Threads to activate when the lock is released */
+    std::vector<ThreadContext *> pendingWakeups;
 };
 
 } // namespace gem5
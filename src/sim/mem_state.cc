@@ -32,6 +32,7 @@
 
 #include "arch/generic/mmu.hh"
 #include "debug/Vma.hh"
+#include "mem/physical.hh"
 #include "mem/se_translating_port_proxy.hh"
 #include "sim/process.hh"
 #include "sim/syscall_debug_macros.hh"
@@ -82,6 +83,8 @@ MemState::resetOwner(Process *owner)
 bool
 MemState::isUnmapped(Addr start_addr, Addr length)
 {
+    std::lock_guard<MemState> guard(*this);
+
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
     for (const auto &vma : _vmaList) {
@@ -95,7 +98,7 @@ MemState::isUnmapped(Addr start_addr, Addr length)
      */
     for (auto start = start_addr; start < end_addr;
          start += _pageBytes) {
-        if (_ownerProcess->pTable->lookup(start) != nullptr) {
+        if (_ownerProcess->pTable->lookup(start)) {
             panic("Someone allocated physical memory at VA %p without "
                   "creating a VMA!\n", start);
             return false;
@@ -107,6 +110,8 @@ MemState::isUnmapped(Addr start_addr, Addr length)
 void
 MemState::updateBrkRegion(Addr old_brk, Addr new_brk)
 {
+    std::lock_guard<MemState> guard(*this);
+
     /**
      * To make this simple, avoid reducing the heap memory area if the
      * new_brk point is less than the old_brk; this occurs when the heap is
@@ -167,6 +172,8 @@ void
 MemState::mapRegion(Addr start_addr, Addr length,
                     const std::string& region_name, int sim_fd, Addr offset)
 {
+    std::lock_guard<MemState> guard(*this);
+
     DPRINTF(Vma, "memstate: creating vma (%s) [0x%x - 0x%x]\n",
             region_name.c_str(), start_addr, start_addr + length);
 
@@ -180,12 +187,15 @@ MemState::mapRegion(Addr start_addr, Addr length,
      * Record the region in our list structure.
      */
     _vmaList.emplace_back(AddrRange(start_addr, start_addr + length),
-                          _pageBytes, region_name, sim_fd, offset);
+                          _pageBytes, region_name, sim_fd, offset,
+                          _ownerProcess->directFileMmap);
 }
 
 void
 MemState::unmapRegion(Addr start_addr, Addr length)
 {
+    std::lock_guard<MemState> guard(*this);
+
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
@@ -283,6 +293,8 @@ MemState::unmapRegion(Addr start_addr, Addr length)
 void
 MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
 {
+    std::lock_guard<MemState> guard(*this);
+
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
@@ -386,6 +398,8 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
 bool
 MemState::fixupFault(Addr vaddr)
 {
+    std::lock_guard<MemState> guard(*this);
+
     /**
      * Check if we are accessing a mapped virtual address. If so then we
      * just haven't allocated it a physical page yet and can do so here.
@@ -401,7 +415,7 @@ MemState::fixupFault(Addr vaddr)
              * This assumption will not hold true if/when physical pages
              * are recycled.
              */
-            if (vma.hasHostBuf()) {
+            if (vma.hasHostBuf() && !mapFilePage(vma, vpage_start)) {
                 /**
                  * Write the memory for the host buffer contents for all
                  * ThreadContexts associated with this process.
@@ -448,9 +462,31 @@ MemState::fixupFault(Addr vaddr)
     return false;
 }
 
+bool
+MemState::mapFilePage(const VMA &vma, Addr vpage_start)
+{
+    if (!_ownerProcess->directFileMmap)
+        return false;
+
+    auto pte = _ownerProcess->pTable->lookup(vpage_start);
+    if (!pte)
+        return false;
+
+    uint8_t *host_addr = _ownerProcess->system->getPhysMem().hostAddr(
+        pte->paddr, _pageBytes);
+    if (!host_addr || !vma.mapMemPage(vpage_start, host_addr))
+        return false;
+
+    DPRINTF(Vma, "memstate: mapped file page at %#x to host %p\n",
+            vpage_start, host_addr);
+    return true;
+}
+
 Addr
 MemState::extendMmap(Addr length)
 {
+    std::lock_guard<MemState> guard(*this);
+
     Addr start = _mmapEnd;
 
     if (_ownerProcess->mmapGrowsDown())
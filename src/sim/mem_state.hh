@@ -34,6 +34,7 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -78,6 +79,17 @@ class MemState : public Serializable
      */
     void resetOwner(Process *owner);
 
+    /**
+     * The memory state is shared by all the threads of a process, which
+     * may be simulated in different event queues. The methods changing the
+     * VMAs take the lock themselves. Syscalls which read and update the
+     * state in several steps (e.g., mmap finding a free region and mapping
+     * it) have to hold the lock for the whole sequence. The lock is
+     * recursive.
+     */
+    void lock() { _mutex.lock(); }
+    void unlock() { _mutex.unlock(); }
+
     /**
      * Get/set base addresses and sizes for the stack and data segments of
      * the process' memory.
@@ -263,6 +275,14 @@ class MemState : public Serializable
      */
     System * system() const;
 
+    /**
+     * Map the file backing the newly allocated page at vpage_start directly
+     * into the host memory of its frame, if the owner process allows it.
+     *
+     * @return Whether the page was mapped; if not, it has to be filled.
+     */
+    bool mapFilePage(const VMA &vma, Addr vpage_start);
+
     /**
      * Owner process of MemState. Used to manipulate page tables.
      */
@@ -295,6 +315,9 @@ class MemState : public Serializable
      * support this or the unmapping method must be changed.
      */
     std::list<VMA> _vmaList;
+
+    /** Lock protecting the memory state, see lock() */
+    std::recursive_mutex _mutex;
 };
 
 } // namespace gem5
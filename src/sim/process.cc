@@ -116,6 +116,8 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
       seWorkload(dynamic_cast<SEWorkload *>(system->workload)),
       useArchPT(params.useArchPT),
       kvmInSE(params.kvmInSE),
+      zeroCopyIO(params.zeroCopyIO),
+      directFileMmap(params.directFileMmap),
       useForClone(false),
       pTable(pTable),
       objFile(obj_file),
@@ -328,7 +330,7 @@ Process::allocateMem(Addr vaddr, int64_t size, bool clobber)
     // a physical page frame to map with the virtual page. Other cores can
     // return if the page has been mapped and `!clobber`.
     if (!clobber) {
-        const EmulationPageTable::Entry *pte = pTable->lookup(page_addr);
+        auto pte = pTable->lookup(page_addr);
         if (pte) {
             warn("Process::allocateMem: addr %#x already mapped\n", vaddr);
             return;
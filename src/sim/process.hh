@@ -178,6 +178,10 @@ class Process : public SimObject
     bool useArchPT;
     // running KVM requires special initialization
     bool kvmInSE;
+    // I/O syscalls may access the backing store of guest memory directly
+    bool zeroCopyIO;
+    // file-backed mmaps may map host files into guest memory directly
+    bool directFileMmap;
     // flag for using the process as a thread which shares page tables
     bool useForClone;
 
@@ -261,6 +261,7 @@ brkFunc(SyscallDesc *desc, ThreadContext *tc, VPtr<> new_brk)
     auto p = tc->getProcessPtr();
 
     std::shared_ptr<MemState> mem_state = p->memState;
+    std::lock_guard<MemState> mem_state_guard(*mem_state);
     Addr brk_point = mem_state->getBrkPoint();
 
     // in Linux at least, brk(0) returns the current break value
@@ -395,6 +395,11 @@ futexFunc(SyscallDesc *desc, ThreadContext *tc,
 
     FutexMap &futex_map = tc->getSystemPtr()->futexMap;
 
+    // Hold the lock of the futex map while checking or updating futex
+    // values, threads running in other event queues may be accessing the
+    // same futexes.
+    std::lock_guard<FutexMap> futex_guard(futex_map);
+
     if (OS::TGT_FUTEX_WAIT == op || OS::TGT_FUTEX_WAIT_BITSET == op) {
         // Ensure futex system call accessed atomically.
         BufferArg buf(uaddr, sizeof(int));
@@ -1274,6 +1279,8 @@ mremapFunc(SyscallDesc *desc, ThreadContext *tc,
     uint64_t provided_address = 0;
     bool use_provided_address = flags & OS::TGT_MREMAP_FIXED;
 
+    std::lock_guard<MemState> mem_state_guard(*p->memState);
+
     if (use_provided_address)
         provided_address = varargs.get<uint64_t>();
 
@@ -1657,6 +1664,8 @@ doClone(SyscallDesc *desc, ThreadContext *tc, RegVal flags, RegVal newStack,
     pp->ppid = (flags & OS::TGT_CLONE_THREAD) ? p->ppid() : p->pid();
     pp->useArchPT = p->useArchPT;
     pp->kvmInSE = p->kvmInSE;
+    pp->zeroCopyIO = p->zeroCopyIO;
+    pp->directFileMmap = p->directFileMmap;
     Process *cp = pp->create();
     // TODO: there is no way to know when the Process SimObject is done with
     // the params pointer. Both the params pointer (pp) and the process
@@ -1789,10 +1798,21 @@ readvFunc(SyscallDesc *desc, ThreadContext *tc,
 
     SETranslatingPortProxy prox(tc);
     typename OS::tgt_iovec tiov[count];
-    struct iovec hiov[count];
+    GuestIovecArg guest_iov(tc);
     for (typename OS::size_t i = 0; i < count; ++i) {
         prox.readBlob(tiov_base + (i * sizeof(typename OS::tgt_iovec)),
                       &tiov[i], sizeof(typename OS::tgt_iovec));
+        guest_iov.add(gtoh(tiov[i].iov_base, OS::byteOrder),
+                      gtoh(tiov[i].iov_len, OS::byteOrder));
+    }
+
+    if (guest_iov.valid()) {
+        int result = readv(sim_fd, guest_iov.iov(), guest_iov.iovcnt());
+        return (result == -1) ? -errno : result;
+    }
+
+    struct iovec hiov[count];
+    for (typename OS::size_t i = 0; i < count; ++i) {
         hiov[i].iov_len = gtoh(tiov[i].iov_len, OS::byteOrder);
         hiov[i].iov_base = new char [hiov[i].iov_len];
     }
@@ -1826,16 +1846,26 @@ writevFunc(SyscallDesc *desc, ThreadContext *tc,
     int sim_fd = hbfdp->getSimFD();
 
     SETranslatingPortProxy prox(tc);
-    struct iovec hiov[count];
+    typename OS::tgt_iovec tiov[count];
+    GuestIovecArg guest_iov(tc);
     for (typename OS::size_t i = 0; i < count; ++i) {
-        typename OS::tgt_iovec tiov;
-
         prox.readBlob(tiov_base + i*sizeof(typename OS::tgt_iovec),
-                      &tiov, sizeof(typename OS::tgt_iovec));
-        hiov[i].iov_len = gtoh(tiov.iov_len, OS::byteOrder);
+                      &tiov[i], sizeof(typename OS::tgt_iovec));
+        guest_iov.add(gtoh(tiov[i].iov_base, OS::byteOrder),
+                      gtoh(tiov[i].iov_len, OS::byteOrder));
+    }
+
+    if (guest_iov.valid()) {
+        int result = writev(sim_fd, guest_iov.iov(), guest_iov.iovcnt());
+        return (result == -1) ? -errno : result;
+    }
+
+    struct iovec hiov[count];
+    for (typename OS::size_t i = 0; i < count; ++i) {
+        hiov[i].iov_len = gtoh(tiov[i].iov_len, OS::byteOrder);
         hiov[i].iov_base = new char [hiov[i].iov_len];
-        prox.readBlob(gtoh(tiov.iov_base, OS::byteOrder), hiov[i].iov_base,
-                      hiov[i].iov_len);
+        prox.readBlob(gtoh(tiov[i].iov_base, OS::byteOrder),
+                      hiov[i].iov_base, hiov[i].iov_len);
     }
 
     int result = writev(sim_fd, hiov, count);
@@ -1933,6 +1963,8 @@ mmapFunc(SyscallDesc *desc, ThreadContext *tc,
         }
     }
 
+    std::lock_guard<MemState> mem_state_guard(*p->memState);
+
     /**
      * Not TGT_MAP_FIXED means we can start wherever we want.
      */
@@ -2001,6 +2033,13 @@ pread64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
+    GuestIovecArg guest_iov(tc);
+    if (guest_iov.add(bufPtr, nbytes)) {
+        int bytes_read = preadv(sim_fd, guest_iov.iov(), guest_iov.iovcnt(),
+                                offset);
+        return (bytes_read == -1) ? -errno : bytes_read;
+    }
+
     BufferArg bufArg(bufPtr, nbytes);
 
     int bytes_read = pread(sim_fd, bufArg.bufferPtr(), nbytes, offset);
@@ -2022,6 +2061,13 @@ pwrite64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
+    GuestIovecArg guest_iov(tc);
+    if (guest_iov.add(bufPtr, nbytes)) {
+        int bytes_written = pwritev(sim_fd, guest_iov.iov(),
+                                    guest_iov.iovcnt(), offset);
+        return (bytes_written == -1) ? -errno : bytes_written;
+    }
+
     BufferArg bufArg(bufPtr, nbytes);
     bufArg.copyIn(SETranslatingPortProxy(tc));
 
@@ -2662,6 +2708,12 @@ readFunc(SyscallDesc *desc, ThreadContext *tc,
         && !(hbfdp->getFlags() & OS::TGT_O_NONBLOCK))
         return SyscallReturn::retry();
 
+    GuestIovecArg guest_iov(tc);
+    if (guest_iov.add(buf_ptr, nbytes)) {
+        int bytes_read = readv(sim_fd, guest_iov.iov(), guest_iov.iovcnt());
+        return (bytes_read == -1) ? -errno : bytes_read;
+    }
+
     BufferArg buf_arg(buf_ptr, nbytes);
     int bytes_read = read(sim_fd, buf_arg.bufferPtr(), nbytes);
 
@@ -2683,8 +2735,12 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = hbfdp->getSimFD();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    buf_arg.copyIn(SETranslatingPortProxy(tc));
+    GuestIovecArg guest_iov(tc);
+    std::unique_ptr<BufferArg> buf_arg;
+    if (!guest_iov.add(buf_ptr, nbytes)) {
+        buf_arg.reset(new BufferArg(buf_ptr, nbytes));
+        buf_arg->copyIn(SETranslatingPortProxy(tc));
+    }
 
     struct pollfd pfd;
     pfd.fd = sim_fd;
@@ -2702,7 +2758,9 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
             return SyscallReturn::retry();
     }
 
-    int bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    int bytes_written = buf_arg ?
+        write(sim_fd, buf_arg->bufferPtr(), nbytes) :
+        writev(sim_fd, guest_iov.iov(), guest_iov.iovcnt());
 
     if (bytes_written != -1)
         fsync(sim_fd);
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2023 The Regents of the University of California.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/syscall_emul_buf.hh"
+
+#include <climits>
+
+#include "cpu/thread_context.hh"
+#include "mem/page_table.hh"
+#include "mem/physical.hh"
+#include "sim/process.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+GuestIovecArg::GuestIovecArg(ThreadContext *tc)
+    : process(tc->getProcessPtr()), _valid(process->zeroCopyIO)
+{
+}
+
+bool
+GuestIovecArg::add(Addr addr, Addr size)
+{
+    if (!_valid)
+        return false;
+
+    const auto &physmem = process->system->getPhysMem();
+    TranslationGenPtr gen = process->pTable->translateRange(addr, size);
+    for (const auto &range : *gen) {
+        uint8_t *host = nullptr;
+        if (range.fault == NoFault)
+            host = physmem.hostAddr(range.paddr, range.size);
+        if (!host) {
+            _valid = false;
+            return false;
+        }
+
+        // Physically contiguous pages usually map to contiguous host
+        // memory, so merge them into a single iovec.
+        if (!iovs.empty() &&
+                (uint8_t *)iovs.back().iov_base + iovs.back().iov_len ==
+                host) {
+            iovs.back().iov_len += range.size;
+        } else if (iovs.size() < IOV_MAX) {
+            iovs.push_back({ host, range.size });
+        } else {
+            _valid = false;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace gem5
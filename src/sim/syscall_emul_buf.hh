@@ -35,7 +35,10 @@
 /// This file defines buffer classes used to handle pointer arguments
 /// in emulated syscalls.
 
+#include <sys/uio.h>
+
 #include <cstring>
+#include <vector>
 
 #include "base/types.hh"
 #include "mem/se_translating_port_proxy.hh"
@@ -43,6 +46,9 @@
 namespace gem5
 {
 
+class Process;
+class ThreadContext;
+
 /**
  * Base class for BufferArg and TypedBufferArg, Not intended to be
  * used directly.
@@ -168,6 +174,44 @@ class TypedBufferArg : public BaseBufferArg
     T &operator[](int i) { return ((T *)bufPtr)[i]; }
 };
 
+/**
+ * Host iovecs pointing directly at buffers in the simulated address
+ * space, which lets I/O syscalls read or write guest memory in place
+ * using the host's scatter-gather calls instead of copying through a
+ * BufferArg.
+ *
+ * The buffers are translated page by page and mapped to the backing
+ * store of the physical memory. This bypasses the memory system, so it
+ * is only used if the process allows it (see Process::zeroCopyIO). If a
+ * buffer isn't mapped, isn't backed by host memory or needs too many
+ * iovecs, the object becomes invalid and the caller has to fall back to
+ * copying.
+ */
+class GuestIovecArg
+{
+  public:
+    GuestIovecArg(ThreadContext *tc);
+
+    /**
+     * Map a buffer in the target address space and append it to the
+     * iovecs.
+     *
+     * @return True if the buffer could be mapped.
+     */
+    bool add(Addr addr, Addr size);
+
+    /** Whether all the buffers added so far could be mapped */
+    bool valid() const { return _valid; }
+
+    struct iovec *iov() { return iovs.data(); }
+    int iovcnt() const { return iovs.size(); }
+
+  private:
+    Process *process;
+    std::vector<struct iovec> iovs;
+    bool _valid;
+};
+
 } // namespace gem5
 
 #endif // __SIM_SYSCALL_EMUL_BUF_HH__
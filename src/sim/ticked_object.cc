@@ -80,10 +80,15 @@ Ticked::regStats()
         .name(object.name() + ".tickCycles")
         .desc("Number of cycles that the object actually ticked");
 
+    skippedCycles
+        .name(object.name() + ".skippedCycles")
+        .desc("Number of cycles that the object was stopped but busy")
+        .prereq(skippedCycles);
+
     idleCycles
         .name(object.name() + ".idleCycles")
         .desc("Total number of cycles that the object has spent stopped");
-    idleCycles = numCycles - tickCycles;
+    idleCycles = numCycles - tickCycles - skippedCycles;
 }
 
 void
@@ -87,7 +87,11 @@ class Ticked : public Serializable
     /** Number of cycles ticked */
     statistics::Scalar tickCycles;
 
-    /** Number of cycles stopped */
+    /** Number of cycles stopped while the object still had work to do,
+     *  which it catches up on when it starts again */
+    statistics::Scalar skippedCycles;
+
+    /** Number of cycles stopped and idle */
     statistics::Formula idleCycles;
 
   public:
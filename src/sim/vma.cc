@@ -28,9 +28,12 @@
 
 #include "sim/vma.hh"
 
+#include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
+#include "base/intmath.hh"
 #include "base/types.hh"
 
 namespace gem5
@@ -50,6 +53,40 @@ VMA::fillMemPages(Addr start, Addr size, PortProxy &port) const
     }
 }
 
+bool
+VMA::mapMemPage(Addr start, uint8_t *host_addr) const
+{
+    if (!hasHostBuf() || _origHostBuf->getFD() == -1)
+        return false;
+
+    auto offset = start - _addrRange.start();
+    if (offset >= _hostBufLen)
+        return false;
+
+    auto file_offset = _origHostBuf->getOffset() + offset +
+        ((uint8_t *)_hostBuf - (uint8_t *)_origHostBuf->getBuffer());
+
+    /**
+     * The host can only map whole host pages. A partial page at the end of
+     * the file is fine as long as it doesn't extend past the host page
+     * holding the end of the file; the host zero-fills the rest of it.
+     */
+    static const Addr host_page_bytes = sysconf(_SC_PAGESIZE);
+    if (_pageBytes % host_page_bytes || file_offset % host_page_bytes ||
+        (uintptr_t)host_addr % host_page_bytes ||
+        roundUp(_hostBufLen - offset, host_page_bytes) < _pageBytes) {
+        return false;
+    }
+
+    void *addr = mmap(host_addr, _pageBytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_FIXED, _origHostBuf->getFD(),
+                      file_offset);
+    panic_if(addr == MAP_FAILED,
+             "Failed to map file into guest memory: %s", strerror(errno));
+
+    return true;
+}
+
 bool
 VMA::isStrictSuperset(const AddrRange &r) const
 {
@@ -119,8 +156,8 @@ VMA::sanityCheck()
 }
 
 VMA::MappedFileBuffer::MappedFileBuffer(int fd, size_t length,
-                                        off_t offset)
-    : _buffer(nullptr), _length(length), _offset(offset)
+                                        off_t offset, bool keep_fd)
+    : _buffer(nullptr), _length(length), _offset(offset), _fd(-1)
 {
     panic_if(_length == 0, "Tried to mmap file of length zero");
 
@@ -145,6 +182,11 @@ VMA::MappedFileBuffer::MappedFileBuffer(int fd, size_t length,
     } else {
         panic("Tried to mmap 0 bytes");
     }
+
+    // Running out of host file descriptors isn't fatal, the pages are
+    // copied from the host buffer instead.
+    if (keep_fd)
+        _fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
 }
 
 VMA::MappedFileBuffer::~MappedFileBuffer()
@@ -154,6 +196,9 @@ VMA::MappedFileBuffer::~MappedFileBuffer()
                  "mmap: failed to unmap file-backed host memory: %s",
                  strerror(errno));
     }
+
+    if (_fd != -1)
+        close(_fd);
 }
 
 } // namespace gem5
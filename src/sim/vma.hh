@@ -46,15 +46,15 @@ class VMA
 
   public:
     VMA(AddrRange r, Addr page_bytes, const std::string& vma_name="anon",
-        int fd=-1, off_t off=0)
+        int fd=-1, off_t off=0, bool direct_map=false)
         : _addrRange(r), _pageBytes(page_bytes), _vmaName(vma_name)
     {
         DPRINTF(Vma, "Creating vma start %#x len %llu end %#x\n",
                 r.start(), r.size(), r.end());
 
         if (fd != -1) {
-            _origHostBuf =
-                std::make_shared<MappedFileBuffer>(fd, r.size(), off);
+            _origHostBuf = std::make_shared<MappedFileBuffer>(
+                fd, r.size(), off, direct_map);
             _hostBuf = _origHostBuf->getBuffer();
             _hostBufLen = _origHostBuf->getLength();
         }
@@ -88,6 +88,18 @@ class VMA
      */
     void fillMemPages(Addr start, Addr size, PortProxy &port) const;
 
+    /**
+     * Map the file contents of the page at start directly into host_addr,
+     * the host memory backing the physical frame of that page. The host
+     * maps the file copy-on-write, so the page is read from the host's
+     * page cache on demand and only copied once it is written.
+     *
+     * @return false if the page can't be mapped directly, e.g., because
+     * the file wasn't opened for direct mapping or the page isn't aligned
+     * to host pages. The page has to be filled with fillMemPages then.
+     */
+    bool mapMemPage(Addr start, uint8_t *host_addr) const;
+
     /**
      * Returns true if desired range exists within this virtual memory area
      * and does not include the start and end addresses.
@@ -185,22 +197,27 @@ class VMA
      * MappedFileBuffer is a wrapper around a region of host memory backed by a
      * file. The constructor attempts to map a file from host memory, and the
      * destructor attempts to unmap it.  If there is a problem with the host
-     * mapping/unmapping, then we panic.
+     * mapping/unmapping, then we panic. If the buffer is used to map pages
+     * directly into guest memory, it keeps its own handle to the file since
+     * the application may close its file descriptor after the mmap.
      */
     class MappedFileBuffer
     {
       public:
-        MappedFileBuffer(int fd, size_t length, off_t offset);
+        MappedFileBuffer(int fd, size_t length, off_t offset,
+                         bool keep_fd=false);
         ~MappedFileBuffer();
 
         void *getBuffer() const { return _buffer; }
         uint64_t getLength() const { return _length; }
         off_t getOffset() const { return _offset; }
+        int getFD() const { return _fd; }
 
       private:
         void *_buffer;       // Host buffer ptr
         size_t _length;       // Length of host ptr
         off_t _offset;       // Offset in file at which mapping starts
+        int _fd;             // Host file descriptor, or -1 if not kept
     };
 };
 
@@ -0,0 +1,306 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2023 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script decodes binary instruction traces written by the
+# BinaryTracer and prints them in the text format of the ExeTracer.
+# The trace fields to print are selected with the same flag names as
+# the ExeTracer debug flags, e.g.:
+#
+# decode_binary_inst_trace.py m5out/system.cpu.tracer.bin.gz \
+#     --flags Exec,ExecFetchSeq --start-pc 0x400000 --end-pc 0x401000
+#
+# Symbol names (ExecSymbol) are not part of the trace and are not
+# printed.
+
+import argparse
+import gzip
+import struct
+import sys
+
+# Layout of the BinaryTracer::InstEntry record
+inst_entry = struct.Struct("<QQQQQQIIIHHBB")
+
+MEM_VALID = 0x01
+FETCH_SEQ_VALID = 0x02
+CP_SEQ_VALID = 0x04
+PREDICATE_FALSE = 0x08
+USER_MODE = 0x10
+
+DATA_INVALID = 0
+DATA_REG = 5
+
+# Flags set by the compound debug flags of the ExeTracer
+compound_flags = {
+    "Exec": [
+        "ExecEnable",
+        "ExecOpClass",
+        "ExecThread",
+        "ExecEffAddr",
+        "ExecResult",
+        "ExecSymbol",
+        "ExecMicro",
+        "ExecMacro",
+        "ExecFaulting",
+        "ExecUser",
+        "ExecKernel",
+    ],
+    "ExecAll": [
+        "ExecEnable",
+        "ExecCPSeq",
+        "ExecEffAddr",
+        "ExecFaulting",
+        "ExecFetchSeq",
+        "ExecOpClass",
+        "ExecRegDelta",
+        "ExecResult",
+        "ExecSymbol",
+        "ExecThread",
+        "ExecMicro",
+        "ExecMacro",
+        "ExecUser",
+        "ExecKernel",
+        "ExecAsid",
+        "ExecFlags",
+    ],
+}
+compound_flags["ExecNoTicks"] = compound_flags["Exec"] + ["FmtTicksOff"]
+
+
+class StaticInst:
+    def __init__(self, kind, op_class, disassembly, flags):
+        self.is_microop = bool(kind & 0x1)
+        self.is_first_microop = bool(kind & 0x2)
+        self.is_last_microop = bool(kind & 0x4)
+        self.op_class = op_class
+        self.disassembly = disassembly
+        self.flags = flags
+
+
+class TraceReader:
+    def __init__(self, f):
+        self.f = f
+
+    def read(self, size):
+        data = self.f.read(size)
+        if len(data) != size:
+            raise EOFError("Truncated instruction trace")
+        return data
+
+    def read_string(self):
+        (size,) = struct.unpack("<H", self.read(2))
+        return self.read(size).decode("utf-8", "replace")
+
+    def entries(self):
+        """Yields (tag, payload) tuples for the entries of the trace."""
+        while True:
+            tag = self.f.read(1)
+            if not tag:
+                return
+            if tag == b"N":
+                yield "N", self.read_string()
+            elif tag == b"S":
+                (inst_id, kind) = struct.unpack("<IB", self.read(5))
+                op_class = self.read_string()
+                disassembly = self.read_string()
+                flags = self.read_string()
+                yield "S", (
+                    inst_id,
+                    StaticInst(kind, op_class, disassembly, flags),
+                )
+            elif tag == b"I":
+                yield "I", inst_entry.unpack(self.read(inst_entry.size))
+            elif tag == b"R":
+                yield "R", self.read_string()
+            else:
+                raise ValueError(f"Unknown trace entry {tag!r}")
+
+
+def format_inst(flags, cpu, entry, inst, ran, result):
+    (
+        when,
+        pc,
+        addr,
+        data,
+        fetch_seq,
+        cp_seq,
+        _,
+        _,
+        asid,
+        micro_pc,
+        thread_id,
+        data_status,
+        entry_flags,
+    ) = entry
+
+    line = ""
+    if "FmtTicksOff" not in flags:
+        line += f"{when:7d}: "
+    line += f"{cpu}: "
+
+    if "ExecAsid" in flags:
+        line += f"A{asid} "
+    if "ExecThread" in flags:
+        line += f"T{thread_id} : "
+
+    line += f"{pc:#x}"
+    line += f".{micro_pc:2d}" if inst.is_microop else "   "
+    line += " : "
+    line += f"{inst.disassembly:<26}"
+
+    if ran:
+        line += " : "
+        if "ExecOpClass" in flags:
+            line += f"{inst.op_class} : "
+        if "ExecResult" in flags and entry_flags & PREDICATE_FALSE:
+            line += "Predicated False"
+        if "ExecResult" in flags and data_status != DATA_INVALID:
+            if data_status == DATA_REG:
+                line += f" D={result}"
+            else:
+                line += f" D={data:#018x}"
+        if "ExecEffAddr" in flags and entry_flags & MEM_VALID:
+            line += f" A={addr:#x}"
+        if "ExecFetchSeq" in flags and entry_flags & FETCH_SEQ_VALID:
+            line += f"  FetchSeq={fetch_seq}"
+        if "ExecCPSeq" in flags and entry_flags & CP_SEQ_VALID:
+            line += f"  CPSeq={cp_seq}"
+        if "ExecFlags" in flags:
+            line += f"  flags=({inst.flags})"
+
+    return line
+
+
+def decode(trace, out, flags, start_pc, end_pc):
+    insts = {}
+    cpu = ""
+    pending = None
+
+    def dump(entry, result):
+        inst = insts[entry[6]]
+        macro = insts.get(entry[7])
+        pc = entry[1]
+        if pc < start_pc or (end_pc is not None and pc >= end_pc):
+            return
+
+        user_mode = entry[12] & USER_MODE
+        if user_mode and "ExecUser" not in flags:
+            return
+        if not user_mode and "ExecKernel" not in flags:
+            return
+
+        # Same macroop handling as ExeTracerRecord::dump()
+        micro = "ExecMicro" in flags
+        if (
+            "ExecMacro" in flags
+            and inst.is_microop
+            and macro is not None
+            and (
+                (micro and inst.is_first_microop)
+                or (not micro and inst.is_last_microop)
+            )
+        ):
+            print(format_inst(flags, cpu, entry, macro, False, None), file=out)
+        if micro or not inst.is_microop:
+            print(format_inst(flags, cpu, entry, inst, True, result), file=out)
+
+    for tag, payload in TraceReader(trace).entries():
+        if tag == "R":
+            dump(pending, payload)
+            pending = None
+            continue
+
+        if pending is not None:
+            dump(pending, None)
+            pending = None
+
+        if tag == "N":
+            cpu = payload
+        elif tag == "S":
+            insts[payload[0]] = payload[1]
+        else:
+            pending = payload
+
+    if pending is not None:
+        dump(pending, None)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a binary instruction trace written by the "
+        "BinaryTracer into the ExeTracer text format."
+    )
+    parser.add_argument("trace", help="The binary trace to decode.")
+    parser.add_argument(
+        "-o",
+        "--output",
+        default="-",
+        help="The text output file, defaults to stdout.",
+    )
+    parser.add_argument(
+        "--flags",
+        default="Exec",
+        help="Comma separated ExeTracer debug flags selecting the fields "
+        "to print.",
+    )
+    parser.add_argument(
+        "--start-pc",
+        type=lambda x: int(x, 0),
+        default=0,
+        help="Only print instructions at or above this PC.",
+    )
+    parser.add_argument(
+        "--end-pc",
+        type=lambda x: int(x, 0),
+        default=None,
+        help="Only print instructions below this PC.",
+    )
+    args = parser.parse_args()
+
+    flags = set()
+    for flag in args.flags.split(","):
+        flags.update(compound_flags.get(flag, [flag]))
+
+    if args.trace.endswith(".gz"):
+        trace = gzip.open(args.trace, "rb")
+    else:
+        trace = open(args.trace, "rb")
+
+    if args.output == "-":
+        out = sys.stdout
+    else:
+        out = open(args.output, "w")
+
+    with trace:
+        decode(trace, out, flags, args.start_pc, args.end_pc)
+
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()